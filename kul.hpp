@@ -14,9 +14,17 @@
  */
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <vector>
 #include <type_traits>
+#include <typeinfo>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_SIMD.hpp>
@@ -787,6 +795,373 @@ inline dynamic_unit cbrt(dynamic_unit const& base)
   return root(base, 3);
 }
 
+// Section [interned]: flat, trivially copyable runtime unit with an interned name
+
+/* dynamic_unit is a tree of heap-allocated nodes, which suits building unit
+ * expressions but makes every copy a deep clone and every query a walk of
+ * virtual calls. interned_unit stores the result of those queries directly:
+ * a dimension, a magnitude, an optional origin and a handle into a
+ * process-wide table that holds the name and the factorization into named
+ * units. Copying it is a memcpy, comparing it needs no table access, and
+ * products of units already seen are a hash lookup, so runtime quantity
+ * arithmetic and conversion allocate nothing once the units involved have
+ * been interned. */
+
+namespace details {
+
+struct interned_factor {
+  std::int32_t atom;
+  int exponent;
+};
+
+struct interned_entry {
+  std::string name;
+  kul::dimension dimension;
+  rational magnitude;
+  std::vector<interned_factor> factors;
+};
+
+class unit_table {
+  std::mutex m_mutex;
+  std::deque<interned_entry> m_entries;
+  // atoms by name, dimension and magnitude: baseline units may share a symbol
+  std::unordered_map<std::string, std::int32_t> m_atoms;
+  // everything by its factorization into atom handles
+  std::unordered_map<std::string, std::int32_t> m_handles;
+  std::unordered_map<std::uint64_t, std::int32_t> m_products;
+  std::unordered_map<std::uint64_t, std::int32_t> m_quotients;
+  static std::uint64_t pair_key(std::int32_t a, std::int32_t b)
+  {
+    return (std::uint64_t(std::uint32_t(a)) << 32) | std::uint64_t(std::uint32_t(b));
+  }
+  static std::string atom_key(std::string const& name, kul::dimension const& d, rational const& m)
+  {
+    return name + "|" + std::to_string(d.time_exponent())
+      + "," + std::to_string(d.length_exponent())
+      + "," + std::to_string(d.mass_exponent())
+      + "," + std::to_string(d.electric_current_exponent())
+      + "," + std::to_string(d.temperature_exponent())
+      + "," + std::to_string(d.amount_of_substance_exponent())
+      + "," + std::to_string(d.luminous_intensity_exponent())
+      + "|" + std::to_string(m.numerator()) + "/" + std::to_string(m.denominator());
+  }
+  static std::string factors_key(std::vector<interned_factor> const& factors)
+  {
+    std::string result;
+    for (auto& factor : factors) {
+      result += std::to_string(factor.atom) + "^" + std::to_string(factor.exponent) + " ";
+    }
+    return result;
+  }
+  std::string name_of(std::vector<interned_factor> const& factors) const
+  {
+    if (factors.empty()) return "1";
+    std::string result;
+    for (auto& factor : factors) {
+      if (!result.empty()) result += " * ";
+      result += m_entries[std::size_t(factor.atom)].name;
+      if (factor.exponent != 1) result += "^" + std::to_string(factor.exponent);
+    }
+    return result;
+  }
+  // callers hold m_mutex
+  std::int32_t find_or_insert(std::vector<interned_factor> const& factors)
+  {
+    auto key = factors_key(factors);
+    auto const it = m_handles.find(key);
+    if (it != m_handles.end()) return it->second;
+    auto d = dimension_one();
+    auto m = rational(1);
+    for (auto& factor : factors) {
+      auto& atom = m_entries[std::size_t(factor.atom)];
+      d = d * kul::pow(atom.dimension, factor.exponent);
+      m = m * kul::pow(atom.magnitude, factor.exponent);
+    }
+    auto const handle = std::int32_t(m_entries.size());
+    m_entries.push_back(interned_entry{name_of(factors), d, m, factors});
+    m_handles.emplace(std::move(key), handle);
+    return handle;
+  }
+ public:
+  static constexpr std::int32_t one = 0;
+  unit_table()
+  {
+    m_entries.push_back(interned_entry{"1", dimension_one(), rational(1), {}});
+    m_handles.emplace(factors_key({}), one);
+  }
+  std::string const& name(std::int32_t handle)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries[std::size_t(handle)].name;
+  }
+  kul::dimension dimension(std::int32_t handle)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries[std::size_t(handle)].dimension;
+  }
+  rational magnitude(std::int32_t handle)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries[std::size_t(handle)].magnitude;
+  }
+  std::int32_t atom(std::string const& name, kul::dimension const& d, rational const& m)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto key = atom_key(name, d, m);
+    auto const it = m_atoms.find(key);
+    if (it != m_atoms.end()) return it->second;
+    auto const handle = std::int32_t(m_entries.size());
+    std::vector<interned_factor> factors = {interned_factor{handle, 1}};
+    m_entries.push_back(interned_entry{name, d, m, factors});
+    m_handles.emplace(factors_key(factors), handle);
+    m_atoms.emplace(std::move(key), handle);
+    return handle;
+  }
+  // a * b if sign is 1, a / b if sign is -1
+  std::int32_t multiply(std::int32_t a, std::int32_t b, int sign)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& memo = (sign > 0) ? m_products : m_quotients;
+    auto const key = pair_key(a, b);
+    auto const it = memo.find(key);
+    if (it != memo.end()) return it->second;
+    auto factors = m_entries[std::size_t(a)].factors;
+    for (auto& new_factor : m_entries[std::size_t(b)].factors) {
+      bool found = false;
+      for (auto& factor : factors) {
+        if (factor.atom == new_factor.atom) {
+          factor.exponent += sign * new_factor.exponent;
+          found = true;
+          break;
+        }
+      }
+      if (!found) factors.push_back(interned_factor{new_factor.atom, sign * new_factor.exponent});
+    }
+    factors.erase(std::remove_if(factors.begin(), factors.end(),
+          [] (interned_factor const& f) { return f.exponent == 0; }), factors.end());
+    auto const handle = find_or_insert(factors);
+    memo.emplace(key, handle);
+    return handle;
+  }
+  // base^(numerator / denominator), which must leave integer exponents
+  std::int32_t power(std::int32_t base, int numerator, int denominator)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto factors = m_entries[std::size_t(base)].factors;
+    for (auto& factor : factors) {
+      if ((factor.exponent * numerator) % denominator != 0) {
+        throw std::runtime_error("taking " + std::to_string(denominator) + "th root of non-divisible "
+            + std::to_string(factor.exponent * numerator) + "th power of "
+            + m_entries[std::size_t(factor.atom)].name);
+      }
+      factor.exponent = (factor.exponent * numerator) / denominator;
+    }
+    factors.erase(std::remove_if(factors.begin(), factors.end(),
+          [] (interned_factor const& f) { return f.exponent == 0; }), factors.end());
+    return find_or_insert(factors);
+  }
+};
+
+inline unit_table& global_unit_table()
+{
+  static unit_table table;
+  return table;
+}
+
+inline std::int32_t intern(unit const& u)
+{
+  auto& table = global_unit_table();
+  if (auto const p = dynamic_cast<dynamic_unit const*>(&u)) return intern(*(p->pointer()));
+  if (dynamic_cast<unit_one const*>(&u)) return unit_table::one;
+  if (auto const p = dynamic_cast<dynamic_product const*>(&u)) {
+    auto result = unit_table::one;
+    for (auto& term : p->terms()) result = table.multiply(result, intern(term), 1);
+    return result;
+  }
+  if (auto const p = dynamic_cast<dynamic_exp const*>(&u)) {
+    return table.power(intern(p->base()), p->exponent(), 1);
+  }
+  // compile-time products and powers expand into their factors through copy()
+  auto const expanded = u.copy();
+  if (typeid(*expanded) != typeid(u)) return intern(*expanded);
+  return table.atom(u.name(), u.dimension(), u.magnitude());
+}
+
+}
+
+class interned_unit {
+  kul::dimension m_dimension{dimension_one()};
+  rational m_magnitude{1};
+  optional<rational> m_origin{nullopt};
+  std::int32_t m_handle{-1};
+  interned_unit(
+      kul::dimension const& dimension_arg,
+      rational const& magnitude_arg,
+      optional<rational> const& origin_arg,
+      std::int32_t handle_arg)
+    :m_dimension(dimension_arg)
+    ,m_magnitude(magnitude_arg)
+    ,m_origin(origin_arg)
+    ,m_handle(handle_arg)
+  {
+  }
+ public:
+  // the default-constructed value means "no unit", like an empty dynamic_unit
+  interned_unit() = default;
+  explicit interned_unit(unit const& u)
+  {
+    auto const as_dynamic = dynamic_cast<dynamic_unit const*>(&u);
+    if (as_dynamic && !(*as_dynamic)) return;
+    m_dimension = u.dimension();
+    m_magnitude = u.magnitude();
+    m_origin = u.origin();
+    m_handle = details::intern(u);
+  }
+  static interned_unit one()
+  {
+    return interned_unit(dimension_one(), rational(1), nullopt, details::unit_table::one);
+  }
+  // a unit known only by its name and definition, e.g. a prefixed symbol read from input
+  static interned_unit named(
+      std::string const& name_arg,
+      kul::dimension const& dimension_arg,
+      rational const& magnitude_arg,
+      optional<rational> const& origin_arg = nullopt)
+  {
+    return interned_unit(dimension_arg, magnitude_arg, origin_arg,
+        details::global_unit_table().atom(name_arg, dimension_arg, magnitude_arg));
+  }
+  std::string const& name() const
+  {
+    static std::string const no_name;
+    if (m_handle < 0) return no_name;
+    return details::global_unit_table().name(m_handle);
+  }
+  kul::dimension const& dimension() const { return m_dimension; }
+  rational const& magnitude() const { return m_magnitude; }
+  optional<rational> const& origin() const { return m_origin; }
+  std::int32_t handle() const { return m_handle; }
+  bool is_unitless() const { return m_handle == details::unit_table::one; }
+  explicit operator bool() const { return m_handle >= 0; }
+  // the same unit measured from zero, as needed to add a difference to it
+  interned_unit relative() const
+  {
+    return interned_unit(m_dimension, m_magnitude, nullopt, m_handle);
+  }
+  // "no unit" is absorbing: any expression involving it has no unit either
+  friend interned_unit operator*(interned_unit const& a, interned_unit const& b)
+  {
+    if (!a || !b) return interned_unit();
+    if (b.is_unitless()) return a;
+    if (a.is_unitless()) return b;
+    return interned_unit(a.m_dimension * b.m_dimension, a.m_magnitude * b.m_magnitude, nullopt,
+        details::global_unit_table().multiply(a.m_handle, b.m_handle, 1));
+  }
+  friend interned_unit operator/(interned_unit const& a, interned_unit const& b)
+  {
+    if (!a || !b) return interned_unit();
+    if (b.is_unitless()) return a;
+    return interned_unit(a.m_dimension / b.m_dimension, a.m_magnitude / b.m_magnitude, nullopt,
+        details::global_unit_table().multiply(a.m_handle, b.m_handle, -1));
+  }
+  friend interned_unit pow(interned_unit const& base, int exponent)
+  {
+    if (!base) return interned_unit();
+    if (exponent == 0) return one();
+    if (exponent == 1) return base;
+    return interned_unit(kul::pow(base.m_dimension, exponent), kul::pow(base.m_magnitude, exponent), nullopt,
+        details::global_unit_table().power(base.m_handle, exponent, 1));
+  }
+  friend interned_unit root(interned_unit const& base, int exponent)
+  {
+    if (!base) return interned_unit();
+    auto& table = details::global_unit_table();
+    auto const handle = table.power(base.m_handle, 1, exponent);
+    return interned_unit(table.dimension(handle), table.magnitude(handle), nullopt, handle);
+  }
+};
+
+static_assert(std::is_trivially_copyable_v<interned_unit>,
+    "interned_unit is meant to be copied as plain bytes");
+
+inline interned_unit sqrt(interned_unit const& base)
+{
+  return root(base, 2);
+}
+
+inline interned_unit cbrt(interned_unit const& base)
+{
+  return root(base, 3);
+}
+
+inline bool operator==(interned_unit const& a, interned_unit const& b)
+{
+  return a.dimension() == b.dimension() &&
+    a.magnitude() == b.magnitude() &&
+    a.origin() == b.origin();
+}
+
+inline bool operator!=(interned_unit const& a, interned_unit const& b)
+{
+  return !operator==(a, b);
+}
+
+inline bool operator==(interned_unit const& a, unit const& b)
+{
+  return a.dimension() == b.dimension() &&
+    a.magnitude() == b.magnitude() &&
+    a.origin() == b.origin();
+}
+
+inline bool operator==(unit const& a, interned_unit const& b)
+{
+  return operator==(b, a);
+}
+
+inline bool operator!=(interned_unit const& a, unit const& b)
+{
+  return !operator==(a, b);
+}
+
+inline bool operator!=(unit const& a, interned_unit const& b)
+{
+  return !operator==(b, a);
+}
+
+}
+
+namespace std {
+
+template <>
+struct hash<kul::interned_unit> {
+  std::size_t operator()(kul::interned_unit const& u) const noexcept
+  {
+    auto const& d = u.dimension();
+    std::uint64_t result = 0;
+    auto const mix = [&] (std::uint64_t v) {
+      result ^= v + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2);
+    };
+    mix(std::uint64_t(d.time_exponent()));
+    mix(std::uint64_t(d.length_exponent()));
+    mix(std::uint64_t(d.mass_exponent()));
+    mix(std::uint64_t(d.electric_current_exponent()));
+    mix(std::uint64_t(d.temperature_exponent()));
+    mix(std::uint64_t(d.amount_of_substance_exponent()));
+    mix(std::uint64_t(d.luminous_intensity_exponent()));
+    mix(std::uint64_t(u.magnitude().numerator()));
+    mix(std::uint64_t(u.magnitude().denominator()));
+    if (u.origin().has_value()) {
+      mix(std::uint64_t(u.origin().value().numerator()));
+      mix(std::uint64_t(u.origin().value().denominator()));
+    }
+    return std::size_t(result);
+  }
+};
+
+}
+
+namespace kul {
+
 // Section [static]: Compile-time implementations of derived unit operations
 
 template <class Base, int Exponent>
@@ -1143,6 +1518,10 @@ class make_relative : public crtp<make_relative<T>> {
 template <class T>
 inline constexpr bool is_absolute = T::static_origin().has_value();
 
+// whether a runtime unit is absolute is only known at runtime
+template <>
+inline constexpr bool is_absolute<dynamic_unit> = false;
+
 template <class T>
 inline constexpr bool is_relative = !is_absolute<T>;
 
@@ -1172,10 +1551,26 @@ class conversion {
         to.origin())
   {
   }
+  inline conversion(interned_unit const& from, interned_unit const& to)
+    :conversion(
+        from.magnitude(),
+        from.origin(),
+        to.magnitude(),
+        to.origin())
+  {
+  }
   KOKKOS_INLINE_FUNCTION constexpr T operator()(T const& old_value) const
   {
     return old_value * m_multiplier + m_offset;
   }
+  KOKKOS_INLINE_FUNCTION constexpr T const& multiplier() const
+  {
+    return m_multiplier;
+  }
+  KOKKOS_INLINE_FUNCTION constexpr T const& offset() const
+  {
+    return m_offset;
+  }
 };
 
 template <class T, class From, class To>
@@ -1489,6 +1884,210 @@ using megajoule_per_kilogram = divide<megajoule, kilogram>;
 using siemens_per_meter = divide<siemens, meter>;
 using pascal_second = multiply<pascal, second>;
 
+// Section [parse]: runtime units from strings such as "kg*m/s^2", cached by string
+
+/* Unit strings in input decks and field metadata repeat the same handful of
+ * spellings many times, so parse_unit memoizes its result per string: only
+ * the first occurrence pays for parsing and interning, later ones are one
+ * hash lookup. The grammar is
+ *
+ *   expression := factor (('*' | '/') factor)*
+ *   factor     := primary ('^' integer)?
+ *   primary    := '(' expression ')' | '1' | symbol
+ *
+ * with '*' and '/' associating to the left, so "J/kg/K" is J/(kg*K). A symbol
+ * is the symbol of a named unit ("m", "Pa", "Ohm", ...), optionally preceded
+ * by the symbol of a metric prefix ("kg", "GPa", "mm"); an exact match wins
+ * over a prefixed reading, so "cd" is the candela and not a centi-something. */
+
+namespace details {
+
+class unit_parser {
+  std::string_view m_text;
+  std::size_t m_position{0};
+  [[noreturn]] void fail(std::string const& what) const
+  {
+    throw std::runtime_error("kul::parse_unit: " + what + " at position "
+        + std::to_string(m_position) + " of \"" + std::string(m_text) + "\"");
+  }
+  static std::unordered_map<std::string, interned_unit> const& symbols()
+  {
+    static std::unordered_map<std::string, interned_unit> const table = {
+      {second::static_name(), interned_unit(second())},
+      {meter::static_name(), interned_unit(meter())},
+      {inch::static_name(), interned_unit(inch())},
+      {gram::static_name(), interned_unit(gram())},
+      {radian::static_name(), interned_unit(radian())},
+      {kelvin::static_name(), interned_unit(kelvin())},
+      {mole::static_name(), interned_unit(mole())},
+      {candela::static_name(), interned_unit(candela())},
+      {ampere::static_name(), interned_unit(ampere())},
+      {coulomb::static_name(), interned_unit(coulomb())},
+      {statampere::static_name(), interned_unit(statampere())},
+      {statcoulomb::static_name(), interned_unit(statcoulomb())},
+      {pascal::static_name(), interned_unit(pascal())},
+      {joule::static_name(), interned_unit(joule())},
+      {watt::static_name(), interned_unit(watt())},
+      {newton::static_name(), interned_unit(newton())},
+      {erg::static_name(), interned_unit(erg())},
+      {volt::static_name(), interned_unit(volt())},
+      {statvolt::static_name(), interned_unit(statvolt())},
+      {ohm::static_name(), interned_unit(ohm())},
+      {siemens::static_name(), interned_unit(siemens())},
+      {farad::static_name(), interned_unit(farad())},
+      {henry::static_name(), interned_unit(henry())}};
+    return table;
+  }
+  static interned_unit prefixed(char prefix, interned_unit const& base)
+  {
+    rational factor(1);
+    switch (prefix) {
+      case 'G': factor = rational(1'000'000'000); break;
+      case 'M': factor = rational(1'000'000); break;
+      case 'k': factor = rational(1'000); break;
+      case 'c': factor = rational(1, 100); break;
+      case 'm': factor = rational(1, 1'000); break;
+      default: return interned_unit();
+    }
+    return interned_unit::named(std::string(1, prefix) + base.name(),
+        base.dimension(), factor * base.magnitude());
+  }
+  void skip_space()
+  {
+    while (m_position < m_text.size() && (m_text[m_position] == ' ' || m_text[m_position] == '\t')) {
+      ++m_position;
+    }
+  }
+  bool accept(char c)
+  {
+    skip_space();
+    if (m_position < m_text.size() && m_text[m_position] == c) {
+      ++m_position;
+      return true;
+    }
+    return false;
+  }
+  static bool is_letter(char c)
+  {
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || c == '_';
+  }
+  static bool is_digit(char c)
+  {
+    return '0' <= c && c <= '9';
+  }
+  int integer()
+  {
+    bool const parenthesized = accept('(');
+    skip_space();
+    bool negative = false;
+    if (m_position < m_text.size() && (m_text[m_position] == '-' || m_text[m_position] == '+')) {
+      negative = (m_text[m_position] == '-');
+      ++m_position;
+    }
+    if (m_position == m_text.size() || !is_digit(m_text[m_position])) fail("expected an integer exponent");
+    int result = 0;
+    while (m_position < m_text.size() && is_digit(m_text[m_position])) {
+      result = result * 10 + (m_text[m_position] - '0');
+      ++m_position;
+    }
+    if (parenthesized && !accept(')')) fail("expected ')'");
+    return negative ? -result : result;
+  }
+  interned_unit symbol()
+  {
+    auto const begin = m_position;
+    while (m_position < m_text.size() && is_letter(m_text[m_position])) ++m_position;
+    auto const name = std::string(m_text.substr(begin, m_position - begin));
+    auto const& table = symbols();
+    auto const exact = table.find(name);
+    if (exact != table.end()) return exact->second;
+    if (name.size() > 1) {
+      auto const base = table.find(name.substr(1));
+      if (base != table.end()) {
+        auto result = prefixed(name[0], base->second);
+        if (result) return result;
+      }
+    }
+    m_position = begin;
+    fail("unknown unit \"" + name + "\"");
+  }
+  interned_unit primary()
+  {
+    if (accept('(')) {
+      auto result = expression();
+      if (!accept(')')) fail("expected ')'");
+      return result;
+    }
+    skip_space();
+    if (m_position < m_text.size() && m_text[m_position] == '1') {
+      ++m_position;
+      return interned_unit::one();
+    }
+    if (m_position == m_text.size() || !is_letter(m_text[m_position])) fail("expected a unit");
+    return symbol();
+  }
+  interned_unit factor()
+  {
+    auto result = primary();
+    if (accept('^')) result = pow(result, integer());
+    return result;
+  }
+  interned_unit expression()
+  {
+    auto result = factor();
+    while (true) {
+      if (accept('*')) result = result * factor();
+      else if (accept('/')) result = result / factor();
+      else return result;
+    }
+  }
+ public:
+  explicit unit_parser(std::string_view text_arg)
+    :m_text(text_arg)
+  {
+  }
+  interned_unit parse()
+  {
+    auto result = expression();
+    skip_space();
+    if (m_position != m_text.size()) fail("unexpected '" + std::string(1, m_text[m_position]) + "'");
+    return result;
+  }
+};
+
+class parsed_unit_cache {
+  std::mutex m_mutex;
+  std::unordered_map<std::string, interned_unit> m_units;
+ public:
+  interned_unit get(std::string_view text)
+  {
+    auto key = std::string(text);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto const it = m_units.find(key);
+      if (it != m_units.end()) return it->second;
+    }
+    // parse unlocked: a racing thread parses the same string to the same unit
+    auto const result = unit_parser(text).parse();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_units.emplace(std::move(key), result);
+    return result;
+  }
+};
+
+inline parsed_unit_cache& global_parsed_unit_cache()
+{
+  static parsed_unit_cache cache;
+  return cache;
+}
+
+}
+
+inline interned_unit parse_unit(std::string_view text)
+{
+  return details::global_parsed_unit_cache().get(text);
+}
+
 // Section [quantity]: class template for runtime value with associated unit
 
 template <class T, class Unit = dynamic_unit>
@@ -2049,7 +2648,7 @@ KOKKOS_INLINE_FUNCTION constexpr auto fma(
 template <class T>
 class quantity<T, dynamic_unit> {
   T m_value;
-  dynamic_unit m_unit;
+  interned_unit m_unit;
  public:
   using value_type = T;
   using unit_type = dynamic_unit;
@@ -2060,20 +2659,143 @@ class quantity<T, dynamic_unit> {
   KOKKOS_DEFAULTED_FUNCTION constexpr quantity& operator=(quantity const&) = default;
   value_type const& value() const { return m_value; }
   value_type& value() { return m_value; }
-  dynamic_unit const& unit() const { return m_unit; }
-  quantity(T const& value_arg, dynamic_unit const& unit_arg)
+  interned_unit const& unit() const { return m_unit; }
+  std::string const& unit_name() const { return m_unit.name(); }
+  quantity(T const& value_arg, interned_unit const& unit_arg)
     :m_value(value_arg)
     ,m_unit(unit_arg)
   {
   }
-  quantity<T, dynamic_unit> in(dynamic_unit const& unit_arg) const
+  quantity(T const& value_arg, kul::unit const& unit_arg)
+    :quantity(value_arg, interned_unit(unit_arg))
+  {
+  }
+  quantity<T, dynamic_unit> in(interned_unit const& unit_arg) const
   {
     auto const c = conversion<T>(unit(), unit_arg);
     auto const new_value = c(value());
     return quantity<T, dynamic_unit>(new_value, unit_arg);
   }
+  quantity<T, dynamic_unit> in(kul::unit const& unit_arg) const
+  {
+    return in(interned_unit(unit_arg));
+  }
 };
 
+namespace details {
+
+inline void check_same_dimension(interned_unit const& a, interned_unit const& b, char const* what)
+{
+  if (a.dimension() != b.dimension()) {
+    throw std::runtime_error(std::string("cannot ") + what +
+        " quantities with different physical dimension: " + a.name() + " and " + b.name());
+  }
+}
+
+// the value of b expressed in unit u, with or without the origin shift
+template <class T>
+T converted_value(quantity<T, dynamic_unit> const& b, interned_unit const& u, bool is_relative)
+{
+  if (b.unit().magnitude() == u.magnitude() &&
+      (is_relative || b.unit().origin() == u.origin())) {
+    return b.value();
+  }
+  if (is_relative) {
+    return conversion<T>(b.unit().magnitude(), nullopt, u.magnitude(), nullopt)(b.value());
+  }
+  return conversion<T>(b.unit(), u)(b.value());
+}
+
+}
+
+template <class T1, class T2>
+auto operator+(quantity<T1, dynamic_unit> const& a, quantity<T2, dynamic_unit> const& b)
+{
+  details::check_same_dimension(a.unit(), b.unit(), "add");
+  auto const a_is_absolute = a.unit().origin().has_value();
+  auto const b_is_absolute = b.unit().origin().has_value();
+  if (a_is_absolute && b_is_absolute) {
+    throw std::runtime_error("cannot add two absolute quantities");
+  }
+  using value_type = decltype(a.value() + b.value());
+  if (b_is_absolute) {
+    return quantity<value_type, dynamic_unit>(
+        b.value() + details::converted_value(a, b.unit(), true), b.unit());
+  }
+  return quantity<value_type, dynamic_unit>(
+      a.value() + details::converted_value(b, a.unit(), true), a.unit());
+}
+
+template <class T1, class T2>
+auto operator-(quantity<T1, dynamic_unit> const& a, quantity<T2, dynamic_unit> const& b)
+{
+  details::check_same_dimension(a.unit(), b.unit(), "subtract");
+  auto const a_is_absolute = a.unit().origin().has_value();
+  auto const b_is_absolute = b.unit().origin().has_value();
+  if ((!a_is_absolute) && b_is_absolute) {
+    throw std::runtime_error("cannot subtract an absolute quantity from a relative one");
+  }
+  using value_type = decltype(a.value() - b.value());
+  if (a_is_absolute && b_is_absolute) {
+    return quantity<value_type, dynamic_unit>(
+        a.value() - details::converted_value(b, a.unit(), false), a.unit().relative());
+  }
+  return quantity<value_type, dynamic_unit>(
+      a.value() - details::converted_value(b, a.unit(), true), a.unit());
+}
+
+template <class T>
+auto operator-(quantity<T, dynamic_unit> const& a)
+{
+  return quantity<T, dynamic_unit>(-a.value(), a.unit());
+}
+
+template <class T1, class T2>
+auto operator*(quantity<T1, dynamic_unit> const& a, quantity<T2, dynamic_unit> const& b)
+{
+  using value_type = decltype(a.value() * b.value());
+  return quantity<value_type, dynamic_unit>(a.value() * b.value(), a.unit() * b.unit());
+}
+
+template <class T1, class T2>
+auto operator/(quantity<T1, dynamic_unit> const& a, quantity<T2, dynamic_unit> const& b)
+{
+  using value_type = decltype(a.value() / b.value());
+  return quantity<value_type, dynamic_unit>(a.value() / b.value(), a.unit() / b.unit());
+}
+
+template <class ValueType, class T,
+         std::enable_if_t<is_value_type<ValueType>, bool> = false>
+auto operator*(ValueType const& a, quantity<T, dynamic_unit> const& b)
+{
+  using value_type = decltype(a * b.value());
+  return quantity<value_type, dynamic_unit>(a * b.value(), b.unit());
+}
+
+template <class ValueType, class T,
+         std::enable_if_t<is_value_type<ValueType>, bool> = false>
+auto operator*(quantity<T, dynamic_unit> const& a, ValueType const& b)
+{
+  using value_type = decltype(a.value() * b);
+  return quantity<value_type, dynamic_unit>(a.value() * b, a.unit());
+}
+
+template <class ValueType, class T,
+         std::enable_if_t<is_value_type<ValueType>, bool> = false>
+auto operator/(ValueType const& a, quantity<T, dynamic_unit> const& b)
+{
+  using value_type = decltype(a / b.value());
+  return quantity<value_type, dynamic_unit>(a / b.value(), interned_unit::one() / b.unit());
+}
+
+template <class ValueType, class T,
+         std::enable_if_t<is_value_type<ValueType>, bool> = false>
+auto operator/(quantity<T, dynamic_unit> const& a, ValueType const& b)
+{
+  using value_type = decltype(a.value() / b);
+  return quantity<value_type, dynamic_unit>(a.value() / b, a.unit());
+}
+
 // Section [named quantity]: convenience typedefs for quantities of named units
 
 template <class T>
@@ -2442,10 +3164,12 @@ class dynamic_unit_system : public unit_system {
 };
 
 template <class StaticUnit, class T>
-quantity<T, StaticUnit> to_static(quantity<T, dynamic_unit> a)
+quantity<T, StaticUnit> to_static(quantity<T, dynamic_unit> const& a)
 {
-  a = a.in(StaticUnit());
-  return quantity<T, StaticUnit>(a.value());
+  auto const c = conversion<T>(
+      a.unit().magnitude(), a.unit().origin(),
+      StaticUnit::static_magnitude(), StaticUnit::static_origin());
+  return quantity<T, StaticUnit>(c(a.value()));
 }
 
 template <class StaticUnit, class T>
@@ -2458,7 +3182,7 @@ quantity<T, StaticUnit> to_static(T const& a, unit_system const& s)
 }
 
 template <class StaticUnit, class T>
-quantity<T, StaticUnit> to_static(quantity<T, dynamic_unit> a, unit_system const& s)
+quantity<T, StaticUnit> to_static(quantity<T, dynamic_unit> const& a, unit_system const& s)
 {
   if (!a.unit()) return to_static<StaticUnit>(a.value(), s);
   return to_static<StaticUnit>(a);
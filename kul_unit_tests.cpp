@@ -580,6 +580,120 @@ TEST(dynamic_quantity, convert)
   EXPECT_FLOAT_EQ(b.value(), 1000.0);
 }
 
+TEST(interned_unit, flat)
+{
+  static_assert(std::is_trivially_copyable_v<kul::interned_unit>,
+      "interned_unit copies as plain bytes");
+  auto const m = kul::interned_unit(kul::meter());
+  auto const s = kul::interned_unit(kul::second());
+  auto const v = m / s;
+  EXPECT_EQ(v.name(), "m * s^-1");
+  EXPECT_EQ(v.dimension(), kul::speed());
+  EXPECT_EQ((v * s).handle(), m.handle());
+  EXPECT_EQ((m / s).handle(), v.handle());
+  EXPECT_TRUE((v / v).is_unitless());
+  EXPECT_EQ((v / v).name(), "1");
+  auto const tree = kul::interned_unit(kul::meter() / (kul::second() * kul::second()));
+  EXPECT_EQ(tree.name(), "m * s^-2");
+  EXPECT_EQ(tree.handle(), (v / s).handle());
+  EXPECT_EQ(kul::sqrt(m * m), m);
+  EXPECT_THROW(kul::sqrt(m), std::runtime_error);
+  auto const si = kul::interned_unit(kul::si().unit(kul::momentum()));
+  EXPECT_EQ(si, kul::kilogram_meter_per_second());
+  EXPECT_EQ(std::hash<kul::interned_unit>()(si),
+      std::hash<kul::interned_unit>()(kul::interned_unit(kul::kilogram_meter_per_second())));
+  EXPECT_NE(kul::interned_unit(kul::kelvin()), kul::make_relative<kul::kelvin>());
+  EXPECT_FALSE(kul::interned_unit());
+  EXPECT_FALSE(kul::interned_unit(kul::dynamic_unit()));
+}
+
+TEST(interned_unit, shared_symbol)
+{
+  auto const time = kul::quantity<double>(2.0, kul::second());
+  auto const resistivity = kul::quantity<double>(3.0, kul::gaussian_resistivity());
+  EXPECT_EQ(time.unit_name(), "s");
+  EXPECT_EQ(resistivity.unit_name(), "s");
+  EXPECT_NE(time.unit().handle(), resistivity.unit().handle());
+  EXPECT_EQ(resistivity.unit(), kul::gaussian_resistivity());
+  EXPECT_EQ((resistivity / time).unit(), kul::gaussian_resistivity() / kul::second());
+  EXPECT_TRUE((resistivity / resistivity).unit().is_unitless());
+}
+
+TEST(interned_unit, no_unit)
+{
+  auto const none = kul::interned_unit();
+  auto const m = kul::interned_unit(kul::meter());
+  EXPECT_FALSE(m * none);
+  EXPECT_FALSE(none * m);
+  EXPECT_FALSE(m / none);
+  EXPECT_FALSE(none / kul::interned_unit::one());
+  EXPECT_FALSE(pow(none, 0));
+  EXPECT_FALSE(kul::sqrt(none));
+  auto const product = kul::quantity<double>(3.0, kul::meter()) * kul::quantity<double>(2.0, kul::dynamic_unit());
+  EXPECT_DOUBLE_EQ(product.value(), 6.0);
+  EXPECT_FALSE(product.unit());
+}
+
+TEST(dynamic_quantity, arithmetic)
+{
+  auto const a = kul::quantity<double>(2.0, kul::kilo<kul::meter>());
+  auto const b = kul::quantity<double>(500.0, kul::meter());
+  auto const sum = a + b;
+  EXPECT_EQ(sum.unit(), kul::kilo<kul::meter>());
+  EXPECT_DOUBLE_EQ(sum.value(), 2.5);
+  EXPECT_DOUBLE_EQ((b - a).value(), -1500.0);
+  auto const t = kul::quantity<double>(4.0, kul::second());
+  auto const speed = a / t;
+  EXPECT_EQ(speed.unit_name(), "km * s^-1");
+  EXPECT_DOUBLE_EQ(speed.in(kul::meter() / kul::second()).value(), 500.0);
+  EXPECT_DOUBLE_EQ((speed * t).in(kul::meter()).value(), 2000.0);
+  EXPECT_DOUBLE_EQ((2.0 * a * 3.0).value(), 12.0);
+  EXPECT_EQ((1.0 / t).unit_name(), "s^-1");
+  EXPECT_THROW(a + t, std::runtime_error);
+  auto const hot = kul::quantity<double>(300.0, kul::kelvin());
+  auto const cold = kul::quantity<double>(290.0, kul::kelvin());
+  auto const step = kul::quantity<double>(5.0, kul::make_relative<kul::kelvin>());
+  EXPECT_DOUBLE_EQ((hot + step).value(), 305.0);
+  EXPECT_TRUE((hot + step).unit().origin().has_value());
+  auto const difference = hot - cold;
+  EXPECT_DOUBLE_EQ(difference.value(), 10.0);
+  EXPECT_FALSE(difference.unit().origin().has_value());
+  EXPECT_THROW(hot + cold, std::runtime_error);
+  EXPECT_THROW(step - hot, std::runtime_error);
+}
+
+TEST(parse_unit, grammar)
+{
+  auto const density = kul::parse_unit("kg/m^3");
+  EXPECT_EQ(density, kul::kilogram_per_cubic_meter());
+  EXPECT_EQ(density.handle(), kul::interned_unit(kul::kilogram_per_cubic_meter()).handle());
+  EXPECT_EQ(kul::parse_unit("g / cm^3"), kul::gram_per_cubic_centimeter());
+  EXPECT_EQ(kul::parse_unit("J/kg/K"), kul::joule_per_kilogram_per_kelvin());
+  EXPECT_EQ(kul::parse_unit("kg*m*s^-2"), kul::newton());
+  EXPECT_EQ(kul::parse_unit("kg*m/(s*s)").handle(), kul::parse_unit("kg * m * s^(-2)").handle());
+  EXPECT_EQ(kul::parse_unit("GPa"), kul::gigapascal());
+  EXPECT_EQ(kul::parse_unit("mm").magnitude(), kul::rational(1, 1000));
+  EXPECT_EQ(kul::parse_unit("mol"), kul::mole());
+  EXPECT_EQ(kul::parse_unit("cd"), kul::candela());
+  EXPECT_EQ(kul::parse_unit("K"), kul::kelvin());
+  EXPECT_EQ(kul::parse_unit("K").relative(), kul::make_relative<kul::kelvin>());
+  EXPECT_TRUE(kul::parse_unit("1").is_unitless());
+  EXPECT_TRUE(kul::parse_unit("m/m").is_unitless());
+  EXPECT_EQ(kul::parse_unit("1/s"), kul::parse_unit("s^-1"));
+  EXPECT_THROW(kul::parse_unit("furlong"), std::runtime_error);
+  EXPECT_THROW(kul::parse_unit("m^"), std::runtime_error);
+  EXPECT_THROW(kul::parse_unit("(m/s"), std::runtime_error);
+  EXPECT_THROW(kul::parse_unit("m s"), std::runtime_error);
+  EXPECT_THROW(kul::parse_unit(""), std::runtime_error);
+}
+
+TEST(parse_unit, quantity)
+{
+  auto const pressure = kul::quantity<double>(2.0, kul::parse_unit("GPa"));
+  EXPECT_DOUBLE_EQ(pressure.in(kul::parse_unit("kg/(m*s^2)")).value(), 2.0e9);
+  EXPECT_EQ(kul::parse_unit(std::string("J/kg")).handle(), kul::parse_unit("J/kg").handle());
+}
+
 TEST(to_static, has_unit)
 {
   auto a = kul::quantity<double>(1.0, kul::kilogram());
@@ -2,8 +2,12 @@
 
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "p3a_dynamic_array.hpp"
+#include "p3a_cholesky.hpp"
+#include "p3a_dynamic_matrix.hpp"
+#include "p3a_eigen.hpp"
 #include "p3a_reduce.hpp"
 
 namespace p3a {
@@ -16,6 +20,28 @@ class convergence_failure : public std::runtime_error {
   }
 };
 
+// Deflated preconditioned conjugate gradient with subspace recycling.
+//
+// When set_deflation_dimension(k) is called with k > 0, the solver keeps
+// up to k vectors W between calls to solve().
+// Each solve then runs the deflated CG of:
+//
+// Saad, Y., Yeung, M., Erhel, J., and Guyomarc'h, F. (2000)
+// "A deflated version of the conjugate gradient algorithm"
+// SIAM J. Sci. Comput., vol 21, pp. 1909-1926.
+//
+// in which the initial guess is corrected by a Galerkin projection onto W
+// and every search direction is kept A-orthogonal to W,
+// so the parts of the spectrum captured by W no longer slow convergence.
+// After a successful solve, the first few search directions of that solve
+// are combined with W in a Rayleigh-Ritz procedure, and the k Ritz vectors
+// with the smallest Ritz values become the W of the next solve.
+// This works well when a sequence of slowly-changing SPD systems is solved,
+// as is the case in time stepping.
+//
+// Because the operator may change between solves, A*W and W^T*A*W are
+// recomputed at the start of each solve, which costs k operator actions.
+
 template <
   class T,
   class Allocator = host_allocator<T>,
@@ -31,6 +57,14 @@ class preconditioned_conjugate_gradient {
   associative_sum<T, Allocator, ExecutionPolicy> m_adder;
   T m_relative_tolerance = 1.0e-6;
   int m_maximum_iterations = 1'000'000;
+  int m_deflation_dimension = 0;
+  int m_harvest_count = 0;
+  std::vector<array_type> m_deflation_vectors;
+  std::vector<array_type> m_deflation_actions;
+  std::vector<array_type> m_harvested_directions;
+  std::vector<T> m_harvested_curvatures;
+  cholesky_factorization<T> m_coarse_cholesky;
+  dynamic_matrix<T> m_coarse_vector;
  public:
   using M_inv_action_type = std::function<
     void(array_type const&, array_type&)>;
@@ -50,11 +84,49 @@ class preconditioned_conjugate_gradient {
   {
     m_maximum_iterations = arg;
   }
+  // number of Ritz vectors retained between solves, zero disables deflation
+  void set_deflation_dimension(int arg)
+  {
+    m_deflation_dimension = arg;
+    if (int(m_deflation_vectors.size()) > arg) clear_deflation_space();
+  }
+  // number of search directions of each solve used to update the deflation space.
+  // zero (the default) means twice the deflation dimension
+  void set_harvest_count(int arg)
+  {
+    m_harvest_count = arg;
+  }
+  void clear_deflation_space()
+  {
+    m_deflation_vectors.clear();
+    m_deflation_actions.clear();
+    m_harvested_directions.clear();
+    m_harvested_curvatures.clear();
+  }
+  [[nodiscard]] int deflation_space_size() const
+  {
+    return int(m_deflation_vectors.size());
+  }
   P3A_NEVER_INLINE int solve(
       M_inv_action_type const& M_inv_action,
       A_action_type const& A_action,
       b_filler_type const& b_filler,
       array_type& x);
+ private:
+  [[nodiscard]] int harvest_limit() const
+  {
+    if (m_deflation_dimension == 0) return 0;
+    if (m_harvest_count > 0) return m_harvest_count;
+    return 2 * m_deflation_dimension;
+  }
+  bool prepare_deflation(A_action_type const& A_action, array_type const& x);
+  void compute_coarse_correction(
+      std::vector<array_type> const& basis,
+      array_type const& v);
+  void subtract_coarse_correction(
+      std::vector<array_type> const& basis,
+      array_type& v);
+  void update_deflation_space();
 };
 
 template <
@@ -99,6 +171,158 @@ P3A_NEVER_INLINE void axpy(
   });
 }
 
+// computes A * W and the Cholesky factor of W^T * A * W for the current operator.
+// returns false (and drops the deflation space) if W is unusable.
+template <
+  class T,
+  class Allocator,
+  class ExecutionPolicy>
+bool preconditioned_conjugate_gradient<T, Allocator, ExecutionPolicy>::prepare_deflation(
+    A_action_type const& A_action,
+    array_type const& x)
+{
+  int const k = int(m_deflation_vectors.size());
+  if (k == 0) return false;
+  if (m_deflation_vectors.front().size() != x.size()) {
+    clear_deflation_space();
+    return false;
+  }
+  m_deflation_actions.resize(std::size_t(k));
+  for (int i = 0; i < k; ++i) {
+    m_deflation_actions[std::size_t(i)].resize(x.size());
+    A_action(m_deflation_vectors[std::size_t(i)], m_deflation_actions[std::size_t(i)]);
+  }
+  dynamic_matrix<T> coarse_matrix(k, k);
+  for (int i = 0; i < k; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      coarse_matrix(i, j) = dot_product(m_adder,
+          m_deflation_vectors[std::size_t(i)], m_deflation_actions[std::size_t(j)]);
+      coarse_matrix(j, i) = coarse_matrix(i, j);
+    }
+  }
+  m_coarse_cholesky.factor(std::move(coarse_matrix));
+  if (!m_coarse_cholesky.is_positive_definite()) {
+    clear_deflation_space();
+    return false;
+  }
+  return true;
+}
+
+// m_coarse_vector = (W^T * A * W)^-1 * basis^T * v
+template <
+  class T,
+  class Allocator,
+  class ExecutionPolicy>
+void preconditioned_conjugate_gradient<T, Allocator, ExecutionPolicy>::compute_coarse_correction(
+    std::vector<array_type> const& basis,
+    array_type const& v)
+{
+  int const k = int(basis.size());
+  m_coarse_vector.resize(k, 1);
+  for (int i = 0; i < k; ++i) {
+    m_coarse_vector(i, 0) = dot_product(m_adder, basis[std::size_t(i)], v);
+  }
+  m_coarse_cholesky.solve_in_place(m_coarse_vector);
+}
+
+// v = v - basis * m_coarse_vector
+template <
+  class T,
+  class Allocator,
+  class ExecutionPolicy>
+void preconditioned_conjugate_gradient<T, Allocator, ExecutionPolicy>::subtract_coarse_correction(
+    std::vector<array_type> const& basis,
+    array_type& v)
+{
+  for (int i = 0; i < int(basis.size()); ++i) {
+    axpy(-m_coarse_vector(i, 0), basis[std::size_t(i)], v, v);
+  }
+}
+
+// Rayleigh-Ritz over Z = [W, P] where P are the harvested search directions.
+// In exact arithmetic the deflated directions are A-conjugate to each other
+// and to W, so Z^T * A * Z = diag(W^T * A * W, p_i^T * A * p_i) is known
+// without further reductions and only Z^T * Z needs to be computed.
+// With Z^T * A * Z = L * L^T, the Ritz values theta satisfy
+// L^-1 * (Z^T * Z) * L^-T * v = (1 / theta) * v, and y = L^-T * v,
+// so the smallest Ritz values are the largest eigenvalues of that matrix.
+template <
+  class T,
+  class Allocator,
+  class ExecutionPolicy>
+void preconditioned_conjugate_gradient<T, Allocator, ExecutionPolicy>::update_deflation_space()
+{
+  int const w = int(m_deflation_vectors.size());
+  int const h = int(m_harvested_directions.size());
+  int const s = w + h;
+  if (h == 0) return;
+  auto const basis = [&] (int i) -> array_type const& {
+    return (i < w) ? m_deflation_vectors[std::size_t(i)] : m_harvested_directions[std::size_t(i - w)];
+  };
+  dynamic_matrix<T> L(s, s);
+  L.assign_zero();
+  for (int i = 0; i < w; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      L(i, j) = m_coarse_cholesky.factors()(i, j);
+    }
+  }
+  for (int i = 0; i < h; ++i) {
+    L(w + i, w + i) = p3a::sqrt(m_harvested_curvatures[std::size_t(i)]);
+  }
+  dynamic_matrix<T> C(s, s);
+  for (int i = 0; i < s; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      C(i, j) = dot_product(m_adder, basis(i), basis(j));
+      C(j, i) = C(i, j);
+    }
+  }
+  solve_lower_triangular(L, C);
+  for (int i = 0; i < s; ++i) {
+    for (int j = 0; j < i; ++j) {
+      p3a::swap(C(i, j), C(j, i));
+    }
+  }
+  solve_lower_triangular(L, C);
+  T C_norm(0);
+  for (int i = 0; i < s; ++i) {
+    for (int j = 0; j < s; ++j) C_norm += C(i, j) * C(i, j);
+  }
+  dynamic_matrix<T> V(s, s);
+  for (int i = 0; i < s; ++i) {
+    for (int j = 0; j < s; ++j) V(i, j) = T(i == j);
+  }
+  // on return the diagonal of C holds the reciprocals 1 / theta of the Ritz values
+  // and the columns of V their vectors, so the largest entries below select
+  // the smallest Ritz values
+  details::cyclic_jacobi_sweeps(C, V, s, epsilon_value<T>() * p3a::sqrt(C_norm));
+  int const k = p3a::min(m_deflation_dimension, s);
+  dynamic_matrix<T> Y(s, k);
+  std::vector<bool> taken(std::size_t(s), false);
+  for (int c = 0; c < k; ++c) {
+    int best = -1;
+    for (int i = 0; i < s; ++i) {
+      if (taken[std::size_t(i)]) continue;
+      if (best == -1 || C(i, i) > C(best, best)) best = i;
+    }
+    taken[std::size_t(best)] = true;
+    for (int i = 0; i < s; ++i) Y(i, c) = V(i, best);
+  }
+  solve_lower_triangular_transpose(L, Y);
+  std::vector<array_type> new_vectors(static_cast<std::size_t>(k));
+  for (int c = 0; c < k; ++c) {
+    auto& ritz_vector = new_vectors[std::size_t(c)];
+    ritz_vector.resize(basis(0).size());
+    fill(ritz_vector.get_execution_policy(), ritz_vector.begin(), ritz_vector.end(), T(0));
+    for (int i = 0; i < s; ++i) {
+      axpy(Y(i, c), basis(i), ritz_vector, ritz_vector);
+    }
+  }
+  m_deflation_vectors = std::move(new_vectors);
+  m_deflation_actions.clear();
+  m_harvested_directions.clear();
+  m_harvested_curvatures.clear();
+}
+
 template <
   class T,
   class Allocator,
@@ -120,6 +344,9 @@ int preconditioned_conjugate_gradient<T, Allocator, ExecutionPolicy>::solve(
   array_type& b = this->m_scratch;
   array_type& Ap = this->m_scratch;
   array_type& Ax = this->m_r;
+  m_harvested_directions.clear();
+  m_harvested_curvatures.clear();
+  bool const is_deflated = prepare_deflation(A_action, x);
   b_filler(b);
   T const b_dot_b = dot_product(m_adder, b, b);
   T const b_magnitude = p3a::sqrt(b_dot_b);
@@ -129,19 +356,38 @@ int preconditioned_conjugate_gradient<T, Allocator, ExecutionPolicy>::solve(
   T const absolute_tolerance = b_magnitude * m_relative_tolerance;
   A_action(x, Ax); // Ax = A * x
   axpy(T(-1), Ax, b, r); // r = A * x - b
+  if (is_deflated) {
+    // x = x + W * (W^T * A * W)^-1 * W^T * r, r = r - A * W * (W^T * A * W)^-1 * W^T * r
+    compute_coarse_correction(m_deflation_vectors, r);
+    for (int i = 0; i < int(m_deflation_vectors.size()); ++i) {
+      axpy(m_coarse_vector(i, 0), m_deflation_vectors[std::size_t(i)], x, x);
+    }
+    subtract_coarse_correction(m_deflation_actions, r);
+  }
   T residual_magnitude = p3a::sqrt(dot_product(m_adder, r, r));
   if (residual_magnitude <= absolute_tolerance) return 0;
   M_inv_action(r, z);  // z = M^-1 * r
   T r_dot_z_old = dot_product(m_adder, r, z); // r^T * z
   copy(p.get_execution_policy(), z.cbegin(), z.cend(), p.begin()); // p = z
+  if (is_deflated) {
+    // p = z - W * (W^T * A * W)^-1 * (A * W)^T * z
+    compute_coarse_correction(m_deflation_actions, z);
+    subtract_coarse_correction(m_deflation_vectors, p);
+  }
+  int const maximum_harvest = harvest_limit();
   for (int k = 1; true; ++k) {
     A_action(p, Ap);
     T const pAp = dot_product(m_adder, p, Ap);
+    if (k <= maximum_harvest && pAp > T(0)) {
+      m_harvested_directions.push_back(p);
+      m_harvested_curvatures.push_back(pAp);
+    }
     T const alpha = r_dot_z_old / pAp; // alpha = (r^T * z) / (p^T * A * p)
     axpy(alpha, p, x, x); // x = x + alpha * p
     axpy(-alpha, Ap, r, r); // r = r - alpha * (A * p)
     residual_magnitude = p3a::sqrt(dot_product(m_adder, r, r));
     if (residual_magnitude <= absolute_tolerance) {
+      update_deflation_space();
       return k;
     }
     if (k == m_maximum_iterations) {
@@ -156,6 +402,11 @@ int preconditioned_conjugate_gradient<T, Allocator, ExecutionPolicy>::solve(
     T const r_dot_z_new = dot_product(m_adder, r, z);
     T const beta = r_dot_z_new / r_dot_z_old;
     axpy(beta, p, z, p); // p = z + beta * p;
+    if (is_deflated) {
+      // p = p - W * (W^T * A * W)^-1 * (A * W)^T * z
+      compute_coarse_correction(m_deflation_actions, z);
+      subtract_coarse_correction(m_deflation_vectors, p);
+    }
     r_dot_z_old = r_dot_z_new;
   }
 }
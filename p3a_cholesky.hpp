@@ -0,0 +1,308 @@
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+
+#include "p3a_dynamic_matrix.hpp"
+
+namespace p3a {
+
+// B = L^{-1} B, reading only the lower triangle of L.
+// columns of B are solved independently in parallel.
+template <class T, class Allocator, class ExecutionPolicy>
+void solve_lower_triangular(
+    dynamic_matrix<T, Allocator, ExecutionPolicy> const& L,
+    dynamic_matrix<T, Allocator, ExecutionPolicy>& B,
+    bool unit_diagonal = false)
+{
+  int const n = L.row_count();
+  if (L.column_count() != n || B.row_count() != n) {
+    throw std::invalid_argument(
+        "lower triangular solve: L not square or B wrong size");
+  }
+  int const column_count = B.column_count();
+  T const* const l = L.data();
+  T* const b = B.data();
+  for_each(B.get_execution_policy(),
+      counting_iterator<int>(0),
+      counting_iterator<int>(column_count),
+  [=] P3A_HOST_DEVICE (int j) P3A_ALWAYS_INLINE {
+    for (int i = 0; i < n; ++i) {
+      T sum = b[i * column_count + j];
+      for (int k = 0; k < i; ++k) {
+        sum -= l[i * n + k] * b[k * column_count + j];
+      }
+      b[i * column_count + j] = unit_diagonal ? sum : sum / l[i * n + i];
+    }
+  });
+}
+
+// B = L^{-T} B, reading only the lower triangle of L
+template <class T, class Allocator, class ExecutionPolicy>
+void solve_lower_triangular_transpose(
+    dynamic_matrix<T, Allocator, ExecutionPolicy> const& L,
+    dynamic_matrix<T, Allocator, ExecutionPolicy>& B,
+    bool unit_diagonal = false)
+{
+  int const n = L.row_count();
+  if (L.column_count() != n || B.row_count() != n) {
+    throw std::invalid_argument(
+        "lower triangular solve: L not square or B wrong size");
+  }
+  int const column_count = B.column_count();
+  T const* const l = L.data();
+  T* const b = B.data();
+  for_each(B.get_execution_policy(),
+      counting_iterator<int>(0),
+      counting_iterator<int>(column_count),
+  [=] P3A_HOST_DEVICE (int j) P3A_ALWAYS_INLINE {
+    for (int i = n - 1; i >= 0; --i) {
+      T sum = b[i * column_count + j];
+      for (int k = i + 1; k < n; ++k) {
+        sum -= l[k * n + i] * b[k * column_count + j];
+      }
+      b[i * column_count + j] = unit_diagonal ? sum : sum / l[i * n + i];
+    }
+  });
+}
+
+/* Cholesky factorization A = L L^T of a symmetric positive definite matrix.
+   Only the lower triangle of A is read and only the lower triangle of
+   factors() is meaningful.
+   Factorization is blocked and right-looking: the diagonal block is factored
+   on the host, the rows below it are solved in parallel, and the trailing
+   update is a lower-triangle-only GEMM, so the cost is about n^3 / 3 flops
+   with no pivot search. */
+
+template <
+  class T,
+  class Allocator = host_allocator<T>,
+  class ExecutionPolicy = execution::sequenced_policy>
+class cholesky_factorization {
+ public:
+  using matrix_type = dynamic_matrix<T, Allocator, ExecutionPolicy>;
+ private:
+  matrix_type m_factors;
+  bool m_is_positive_definite = true;
+  int m_block_size = 64;
+ public:
+  cholesky_factorization() = default;
+  explicit cholesky_factorization(matrix_type const& a)
+  {
+    factor(a);
+  }
+  void set_block_size(int block_size_arg)
+  {
+    if (block_size_arg < 1) {
+      throw std::invalid_argument("Cholesky factorization: block size must be positive");
+    }
+    m_block_size = block_size_arg;
+  }
+  void factor(matrix_type const& a)
+  {
+    m_factors = a;
+    factor_in_place();
+  }
+  void factor(matrix_type&& a)
+  {
+    m_factors = std::move(a);
+    factor_in_place();
+  }
+  [[nodiscard]] int size() const { return m_factors.row_count(); }
+  // false if a non-positive pivot was found, in which case factoring stopped there
+  [[nodiscard]] bool is_positive_definite() const { return m_is_positive_definite; }
+  [[nodiscard]] matrix_type const& factors() const { return m_factors; }
+  void solve(matrix_type const& b, matrix_type& x) const
+  {
+    x = b;
+    solve_in_place(x);
+  }
+  void solve_in_place(matrix_type& b) const
+  {
+    if (!m_is_positive_definite) {
+      throw std::invalid_argument("Cholesky solve: matrix is not positive definite");
+    }
+    solve_lower_triangular(m_factors, b);
+    solve_lower_triangular_transpose(m_factors, b);
+  }
+  [[nodiscard]] T determinant() const
+  {
+    T result = T(1);
+    for (int i = 0; i < size(); ++i) result *= square(m_factors(i, i));
+    return result;
+  }
+ private:
+  void factor_in_place()
+  {
+    int const n = m_factors.row_count();
+    if (m_factors.column_count() != n) {
+      throw std::invalid_argument("Cholesky factorization: matrix not square");
+    }
+    m_is_positive_definite = true;
+    auto& a = m_factors;
+    for (int k0 = 0; k0 < n; k0 += m_block_size) {
+      int const k1 = p3a::min(n, k0 + m_block_size);
+      for (int j = k0; j < k1; ++j) {
+        T diagonal = a(j, j);
+        for (int k = k0; k < j; ++k) diagonal -= square(a(j, k));
+        if (!(diagonal > T(0))) {
+          m_is_positive_definite = false;
+          return;
+        }
+        a(j, j) = p3a::sqrt(diagonal);
+        for (int i = j + 1; i < k1; ++i) {
+          T value = a(i, j);
+          for (int k = k0; k < j; ++k) value -= a(i, k) * a(j, k);
+          a(i, j) = value / a(j, j);
+        }
+      }
+      if (k1 == n) break;
+      // L21 = A21 L11^{-T}, one independent row per thread
+      T* const l = a.data();
+      for_each(a.get_execution_policy(),
+          counting_iterator<int>(k1),
+          counting_iterator<int>(n),
+      [=] P3A_HOST_DEVICE (int i) P3A_ALWAYS_INLINE {
+        for (int j = k0; j < k1; ++j) {
+          T value = l[i * n + j];
+          for (int k = k0; k < j; ++k) value -= l[i * n + k] * l[j * n + k];
+          l[i * n + j] = value / l[j * n + j];
+        }
+      });
+      // A22 = A22 - L21 L21^T, lower triangle only
+      auto const l21 = std::as_const(a).view().submatrix(k1, k0, n - k1, k1 - k0);
+      details::gemm(T(-1), l21, l21.transpose(),
+          T(1), a.view().submatrix(k1, k1, n - k1, n - k1), true);
+    }
+  }
+};
+
+/* LDL^T factorization A = L D L^T of a symmetric matrix without pivoting,
+   with L unit lower triangular and D diagonal.
+   It avoids square roots, so it also works for symmetric quasi-definite
+   matrices whose D has mixed signs.
+   factors() holds D on its diagonal and L strictly below it. */
+
+template <
+  class T,
+  class Allocator = host_allocator<T>,
+  class ExecutionPolicy = execution::sequenced_policy>
+class ldlt_factorization {
+ public:
+  using matrix_type = dynamic_matrix<T, Allocator, ExecutionPolicy>;
+ private:
+  matrix_type m_factors;
+  matrix_type m_scaled_panel;
+  bool m_is_singular = false;
+  int m_block_size = 64;
+ public:
+  ldlt_factorization() = default;
+  explicit ldlt_factorization(matrix_type const& a)
+  {
+    factor(a);
+  }
+  void set_block_size(int block_size_arg)
+  {
+    if (block_size_arg < 1) {
+      throw std::invalid_argument("LDLT factorization: block size must be positive");
+    }
+    m_block_size = block_size_arg;
+  }
+  void factor(matrix_type const& a)
+  {
+    m_factors = a;
+    factor_in_place();
+  }
+  void factor(matrix_type&& a)
+  {
+    m_factors = std::move(a);
+    factor_in_place();
+  }
+  [[nodiscard]] int size() const { return m_factors.row_count(); }
+  // true if a zero pivot was found, in which case factoring stopped there
+  [[nodiscard]] bool is_singular() const { return m_is_singular; }
+  [[nodiscard]] matrix_type const& factors() const { return m_factors; }
+  [[nodiscard]] T diagonal(int i) const { return m_factors(i, i); }
+  void solve(matrix_type const& b, matrix_type& x) const
+  {
+    x = b;
+    solve_in_place(x);
+  }
+  void solve_in_place(matrix_type& b) const
+  {
+    if (m_is_singular) {
+      throw std::invalid_argument("LDLT solve: matrix is singular");
+    }
+    solve_lower_triangular(m_factors, b, true);
+    int const n = size();
+    int const column_count = b.column_count();
+    T const* const ld = m_factors.data();
+    T* const x = b.data();
+    for_each(b.get_execution_policy(),
+        counting_iterator<std::int64_t>(0),
+        counting_iterator<std::int64_t>(std::int64_t(n) * column_count),
+    [=] P3A_HOST_DEVICE (std::int64_t ij) P3A_ALWAYS_INLINE {
+      int const i = int(ij / column_count);
+      x[ij] /= ld[i * n + i];
+    });
+    solve_lower_triangular_transpose(m_factors, b, true);
+  }
+  [[nodiscard]] T determinant() const
+  {
+    T result = T(1);
+    for (int i = 0; i < size(); ++i) result *= m_factors(i, i);
+    return result;
+  }
+ private:
+  void factor_in_place()
+  {
+    int const n = m_factors.row_count();
+    if (m_factors.column_count() != n) {
+      throw std::invalid_argument("LDLT factorization: matrix not square");
+    }
+    m_is_singular = false;
+    auto& a = m_factors;
+    for (int k0 = 0; k0 < n; k0 += m_block_size) {
+      int const k1 = p3a::min(n, k0 + m_block_size);
+      int const kb = k1 - k0;
+      for (int j = k0; j < k1; ++j) {
+        T d = a(j, j);
+        for (int k = k0; k < j; ++k) d -= square(a(j, k)) * a(k, k);
+        if (d == T(0)) {
+          m_is_singular = true;
+          return;
+        }
+        a(j, j) = d;
+        for (int i = j + 1; i < k1; ++i) {
+          T value = a(i, j);
+          for (int k = k0; k < j; ++k) value -= a(i, k) * a(k, k) * a(j, k);
+          a(i, j) = value / d;
+        }
+      }
+      if (k1 == n) break;
+      // L21 = A21 L11^{-T} D1^{-1} and W = L21 D1, one independent row per thread
+      m_scaled_panel.resize(n - k1, kb);
+      T* const l = a.data();
+      T* const w = m_scaled_panel.data();
+      for_each(a.get_execution_policy(),
+          counting_iterator<int>(k1),
+          counting_iterator<int>(n),
+      [=] P3A_HOST_DEVICE (int i) P3A_ALWAYS_INLINE {
+        T* const w_row = w + std::ptrdiff_t(i - k1) * kb;
+        for (int j = k0; j < k1; ++j) {
+          T value = l[i * n + j];
+          for (int k = k0; k < j; ++k) value -= w_row[k - k0] * l[j * n + k];
+          w_row[j - k0] = value;
+          l[i * n + j] = value / l[j * n + j];
+        }
+      });
+      // A22 = A22 - L21 W^T, lower triangle only
+      details::gemm(T(-1),
+          std::as_const(a).view().submatrix(k1, k0, n - k1, kb),
+          std::as_const(m_scaled_panel).view().transpose(),
+          T(1), a.view().submatrix(k1, k1, n - k1, n - k1), true);
+    }
+  }
+};
+
+}
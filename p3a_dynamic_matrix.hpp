@@ -1,16 +1,142 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <stdexcept>
+#include <type_traits>
 
 #include "p3a_dynamic_array.hpp"
+#include "p3a_for_each.hpp"
+#include "p3a_counting_iterator.hpp"
+#include "p3a_simd.hpp"
 
 namespace p3a {
 
+// storage orders for dynamic_matrix: entry (i, j) of an m x n matrix is at
+// index(i, j, m, n), which is also row_stride(m, n) * i + column_stride(m, n) * j
+struct row_major_layout {
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  std::ptrdiff_t row_stride(int, int column_count) { return column_count; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  std::ptrdiff_t column_stride(int, int) { return 1; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  std::ptrdiff_t index(int i, int j, int, int column_count)
+  {
+    return std::ptrdiff_t(i) * column_count + j;
+  }
+};
+
+struct column_major_layout {
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  std::ptrdiff_t row_stride(int, int) { return 1; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  std::ptrdiff_t column_stride(int row_count, int) { return row_count; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  std::ptrdiff_t index(int i, int j, int row_count, int)
+  {
+    return i + std::ptrdiff_t(j) * row_count;
+  }
+};
+
+/* A non-owning view of a matrix in memory whose (i, j) entry is at
+   data()[i * row_stride() + j * column_stride()].
+   Submatrices, transposes, rows and columns are all views of the same
+   memory, so blocked algorithms can operate in place without copies.
+   Views are trivially copyable and can be captured by device lambdas;
+   T may be const-qualified for read-only views. */
+
+template <class T, class ExecutionPolicy = execution::sequenced_policy>
+class dynamic_matrix_view {
+  T* m_data;
+  int m_row_count;
+  int m_column_count;
+  std::ptrdiff_t m_row_stride;
+  std::ptrdiff_t m_column_stride;
+ public:
+  using value_type = std::remove_const_t<T>;
+  using execution_policy = ExecutionPolicy;
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  dynamic_matrix_view()
+    :m_data(nullptr)
+    ,m_row_count(0)
+    ,m_column_count(0)
+    ,m_row_stride(0)
+    ,m_column_stride(0)
+  {}
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  dynamic_matrix_view(
+      T* data_arg,
+      int row_count_arg,
+      int column_count_arg,
+      std::ptrdiff_t row_stride_arg,
+      std::ptrdiff_t column_stride_arg)
+    :m_data(data_arg)
+    ,m_row_count(row_count_arg)
+    ,m_column_count(column_count_arg)
+    ,m_row_stride(row_stride_arg)
+    ,m_column_stride(column_stride_arg)
+  {}
+  template <class U,
+            typename std::enable_if<std::is_convertible_v<U*, T*>, bool>::type = false>
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  dynamic_matrix_view(dynamic_matrix_view<U, ExecutionPolicy> const& other)
+    :m_data(other.data())
+    ,m_row_count(other.row_count())
+    ,m_column_count(other.column_count())
+    ,m_row_stride(other.row_stride())
+    ,m_column_stride(other.column_stride())
+  {}
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  T* data() const { return m_data; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  int row_count() const { return m_row_count; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  int column_count() const { return m_column_count; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  std::ptrdiff_t row_stride() const { return m_row_stride; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  std::ptrdiff_t column_stride() const { return m_column_stride; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  T& operator()(int i, int j) const
+  {
+    return m_data[i * m_row_stride + j * m_column_stride];
+  }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  dynamic_matrix_view submatrix(
+      int first_row, int first_column,
+      int row_count_arg, int column_count_arg) const
+  {
+    return dynamic_matrix_view(
+        m_data + first_row * m_row_stride + first_column * m_column_stride,
+        row_count_arg, column_count_arg,
+        m_row_stride, m_column_stride);
+  }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  dynamic_matrix_view transpose() const
+  {
+    return dynamic_matrix_view(m_data,
+        m_column_count, m_row_count,
+        m_column_stride, m_row_stride);
+  }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  dynamic_matrix_view row(int i) const
+  {
+    return submatrix(i, 0, 1, m_column_count);
+  }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  dynamic_matrix_view column(int j) const
+  {
+    return submatrix(0, j, m_row_count, 1);
+  }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+  ExecutionPolicy get_execution_policy() const { return ExecutionPolicy(); }
+};
+
 template <
   class T,
   class Allocator = host_allocator<T>,
-  class ExecutionPolicy = execution::sequenced_policy>
+  class ExecutionPolicy = execution::sequenced_policy,
+  class Layout = row_major_layout>
 class dynamic_matrix {
   int m_row_count;
   int m_column_count;
@@ -31,37 +157,61 @@ class dynamic_matrix {
   {
   }
   void assign_zero() {
-    for (int i = 0; i < m_row_count; ++i) {
-      for (int j = 0; j < m_column_count; ++j) {
-        operator()(i, j) = T(0);
-      }
-    }
+    fill(m_storage.get_execution_policy(), m_storage.begin(), m_storage.end(), T(0));
   }
+  // contents are unspecified after a change of shape.
+  // capacity is kept, and growing clears first so old entries are not moved.
   void resize(int new_row_count, int new_column_count)
   {
-    if (new_row_count != m_row_count || new_column_count != m_column_count) {
-      m_storage.resize(0);
-      m_storage.resize(new_row_count * new_column_count);
-      m_row_count = new_row_count;
-      m_column_count = new_column_count;
-    }
+    if (new_row_count == m_row_count && new_column_count == m_column_count) return;
+    auto const new_size = std::int64_t(new_row_count) * new_column_count;
+    if (new_size > m_storage.capacity()) m_storage.clear();
+    m_storage.resize(new_size);
+    m_row_count = new_row_count;
+    m_column_count = new_column_count;
   }
   [[nodiscard]] P3A_ALWAYS_INLINE inline constexpr
   int row_count() const { return m_row_count; }
   [[nodiscard]] P3A_ALWAYS_INLINE inline constexpr
   int column_count() const { return m_column_count; }
   [[nodiscard]] P3A_ALWAYS_INLINE inline constexpr
-  T& operator()(int i, int j) { return m_storage[i * m_column_count + j]; }
+  T& operator()(int i, int j)
+  {
+    return m_storage[Layout::index(i, j, m_row_count, m_column_count)];
+  }
+  [[nodiscard]] P3A_ALWAYS_INLINE inline constexpr
+  T const& operator()(int i, int j) const
+  {
+    return m_storage[Layout::index(i, j, m_row_count, m_column_count)];
+  }
+  [[nodiscard]] P3A_ALWAYS_INLINE inline constexpr
+  std::ptrdiff_t row_stride() const { return Layout::row_stride(m_row_count, m_column_count); }
+  [[nodiscard]] P3A_ALWAYS_INLINE inline constexpr
+  std::ptrdiff_t column_stride() const { return Layout::column_stride(m_row_count, m_column_count); }
   [[nodiscard]] P3A_ALWAYS_INLINE inline constexpr
-  T const& operator()(int i, int j) const { return m_storage[i * m_column_count + j]; }
+  T* data() { return m_storage.data(); }
+  [[nodiscard]] P3A_ALWAYS_INLINE inline constexpr
+  T const* data() const { return m_storage.data(); }
+  [[nodiscard]] P3A_ALWAYS_INLINE inline
+  ExecutionPolicy get_execution_policy() const { return m_storage.get_execution_policy(); }
+  [[nodiscard]] P3A_ALWAYS_INLINE inline
+  dynamic_matrix_view<T, ExecutionPolicy> view()
+  {
+    return {data(), m_row_count, m_column_count, row_stride(), column_stride()};
+  }
+  [[nodiscard]] P3A_ALWAYS_INLINE inline
+  dynamic_matrix_view<T const, ExecutionPolicy> view() const
+  {
+    return {data(), m_row_count, m_column_count, row_stride(), column_stride()};
+  }
 };
 
-template <class T, class Allocator, class ExecutionPolicy>
+template <class T, class Allocator, class ExecutionPolicy, class Layout>
 void axpy(
     T a,
-    dynamic_matrix<T, Allocator, ExecutionPolicy> const& x,
-    dynamic_matrix<T, Allocator, ExecutionPolicy> const& y,
-    dynamic_matrix<T, Allocator, ExecutionPolicy>& result)
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout> const& x,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout> const& y,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& result)
 {
   int n = x.row_count();
   int m = x.column_count();
@@ -69,53 +219,409 @@ void axpy(
     throw std::invalid_argument("dense axpy: y wrong size");
   }
   result.resize(n, m);
-  for (int i = 0; i < n; ++i) {
-    for (int j = 0; j < m; ++j) {
-      result(i, j) = a * x(i, j) + y(i, j);
+  // all three share a layout, so their storage can be treated as one flat range
+  T const* const x_ptr = x.data();
+  T const* const y_ptr = y.data();
+  T* const result_ptr = result.data();
+  for_each(result.get_execution_policy(),
+      counting_iterator<std::int64_t>(0),
+      counting_iterator<std::int64_t>(std::int64_t(n) * m),
+  [=] P3A_HOST_DEVICE (std::int64_t k) P3A_ALWAYS_INLINE {
+    result_ptr[k] = a * x_ptr[k] + y_ptr[k];
+  });
+}
+
+namespace details {
+
+// GPU policies get one thread per entry of C instead of the packed kernel,
+// whose parallelism is only one thread per block of rows
+template <class ExecutionPolicy>
+inline constexpr bool is_gpu_policy_v = false;
+#ifdef KOKKOS_ENABLE_CUDA
+template <>
+inline constexpr bool is_gpu_policy_v<execution::cuda_policy> = true;
+#endif
+#ifdef KOKKOS_ENABLE_HIP
+template <>
+inline constexpr bool is_gpu_policy_v<execution::hip_policy> = true;
+#endif
+
+// blocking parameters of the packed GEMM, following Goto and van de Geijn (2008):
+// an mr x nr block of C is held in SIMD registers, a kc x nr sliver of B stays in L1
+// and an mc x kc block of A stays in L2
+template <class T, class Abi>
+struct gemm_blocking {
+  using simd_type = simd<T, Abi>;
+  static constexpr int width = int(simd_type::size());
+  static constexpr int vectors_per_row = (width >= 4) ? 2 : (4 / width);
+  static constexpr int mr = 4;
+  static constexpr int nr = vectors_per_row * width;
+  static constexpr int kc = 256;
+  static constexpr int mc = 32 * mr;
+  static constexpr int nc = (4096 / nr) * nr;
+};
+
+// copies rows [row_begin, row_begin + row_count) and columns [k_begin, k_begin + k_count)
+// of A into slivers of mr rows, each stored column by column and padded with zeros
+template <class T, class Abi, class ExecutionPolicy>
+P3A_HOST_DEVICE inline
+void gemm_pack_a(
+    dynamic_matrix_view<T const, ExecutionPolicy> a,
+    int row_begin, int row_count,
+    int k_begin, int k_count,
+    T* packed)
+{
+  constexpr int mr = gemm_blocking<T, Abi>::mr;
+  for (int ir = 0; ir < row_count; ir += mr) {
+    for (int k = 0; k < k_count; ++k) {
+      for (int r = 0; r < mr; ++r) {
+        packed[r] = (ir + r < row_count) ? a(row_begin + ir + r, k_begin + k) : T(0);
+      }
+      packed += mr;
     }
   }
 }
 
-template <class T, class Allocator, class ExecutionPolicy>
-void multiply(
-    dynamic_matrix<T, Allocator, ExecutionPolicy> const& a,
-    dynamic_matrix<T, Allocator, ExecutionPolicy> const& b,
-    dynamic_matrix<T, Allocator, ExecutionPolicy>& result)
+// copies one sliver of at most nr columns of B, stored row by row and padded with zeros
+template <class T, class Abi, class ExecutionPolicy>
+P3A_HOST_DEVICE inline
+void gemm_pack_b_sliver(
+    dynamic_matrix_view<T const, ExecutionPolicy> b,
+    int k_begin, int k_count,
+    int column_begin, int column_count,
+    T* packed)
 {
-  int const n = a.row_count();
-  int const m = b.column_count();
-  int const o = a.column_count();
-  if (o != b.row_count()) {
-    throw std::invalid_argument(
-        "dense matrix multiply: LHS columns != RHS rows");
+  constexpr int nr = gemm_blocking<T, Abi>::nr;
+  for (int k = 0; k < k_count; ++k) {
+    for (int c = 0; c < nr; ++c) {
+      packed[c] = (c < column_count) ? b(k_begin + k, column_begin + c) : T(0);
+    }
+    packed += nr;
+  }
+}
+
+// tile = (packed A sliver) * (packed B sliver), an mr x nr row-major tile
+template <class T, class Abi>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void gemm_micro_kernel(
+    int k_count,
+    T const* a,
+    T const* b,
+    T* tile)
+{
+  using blocking = gemm_blocking<T, Abi>;
+  using simd_type = typename blocking::simd_type;
+  constexpr int mr = blocking::mr;
+  constexpr int nr = blocking::nr;
+  constexpr int width = blocking::width;
+  constexpr int vectors_per_row = blocking::vectors_per_row;
+  simd_type c[mr][vectors_per_row];
+  for (int i = 0; i < mr; ++i) {
+    for (int v = 0; v < vectors_per_row; ++v) {
+      c[i][v] = simd_type(T(0));
+    }
   }
-  for (int j = 0; j < m; ++j) {
-    for (int i = 0; i < n; ++i) {
-      T value(0);
-      for (int k = 0; k < o; ++k) {
-        value += a(i, k) * b(k, j);
+  for (int k = 0; k < k_count; ++k) {
+    simd_type b_row[vectors_per_row];
+    for (int v = 0; v < vectors_per_row; ++v) {
+      b_row[v].copy_from(b + v * width, element_aligned_tag());
+    }
+    for (int i = 0; i < mr; ++i) {
+      simd_type const a_value(a[i]);
+      for (int v = 0; v < vectors_per_row; ++v) {
+        c[i][v] += a_value * b_row[v];
       }
-      result(i, j) = value;
     }
+    a += mr;
+    b += nr;
+  }
+  for (int i = 0; i < mr; ++i) {
+    for (int v = 0; v < vectors_per_row; ++v) {
+      c[i][v].copy_to(tile + i * nr + v * width, element_aligned_tag());
+    }
+  }
+}
+
+// one thread per entry of C, used on GPUs and for products too small to pack
+template <class T, class ExecutionPolicy>
+P3A_NEVER_INLINE
+void gemm_direct(
+    T alpha,
+    dynamic_matrix_view<T const, ExecutionPolicy> a,
+    dynamic_matrix_view<T const, ExecutionPolicy> b,
+    T beta,
+    dynamic_matrix_view<T, ExecutionPolicy> c,
+    bool lower_only)
+{
+  int const n = c.column_count();
+  int const k = a.column_count();
+  for_each(c.get_execution_policy(),
+      counting_iterator<std::int64_t>(0),
+      counting_iterator<std::int64_t>(std::int64_t(c.row_count()) * n),
+  [=] P3A_HOST_DEVICE (std::int64_t ij) P3A_ALWAYS_INLINE {
+    int const i = int(ij / n);
+    int const j = int(ij % n);
+    if (lower_only && j > i) return;
+    T sum(0);
+    for (int l = 0; l < k; ++l) {
+      sum += a(i, l) * b(l, j);
+    }
+    c(i, j) = alpha * sum + ((beta == T(0)) ? T(0) : beta * c(i, j));
+  });
+}
+
+template <class T, class ExecutionPolicy>
+P3A_NEVER_INLINE
+void gemm_packed(
+    T alpha,
+    dynamic_matrix_view<T const, ExecutionPolicy> a,
+    dynamic_matrix_view<T const, ExecutionPolicy> b,
+    T beta,
+    dynamic_matrix_view<T, ExecutionPolicy> c,
+    bool lower_only)
+{
+  using abi_type = typename ExecutionPolicy::simd_abi_type;
+  using blocking = gemm_blocking<T, abi_type>;
+  constexpr int mr = blocking::mr;
+  constexpr int nr = blocking::nr;
+  constexpr int kc = blocking::kc;
+  constexpr int mc = blocking::mc;
+  constexpr int nc = blocking::nc;
+  auto const policy = c.get_execution_policy();
+  int const m = c.row_count();
+  int const n = c.column_count();
+  int const k = a.column_count();
+  int const block_count = (m + mc - 1) / mc;
+  dynamic_array<T, host_allocator<T>, ExecutionPolicy> packed_a(
+      std::int64_t((m + mr - 1) / mr) * mr * kc);
+  dynamic_array<T, host_allocator<T>, ExecutionPolicy> packed_b(
+      std::int64_t((p3a::min(n, nc) + nr - 1) / nr) * nr * kc);
+  T* const a_ptr = packed_a.data();
+  T* const b_ptr = packed_b.data();
+  for (int jc = 0; jc < n; jc += nc) {
+    int const nb = p3a::min(nc, n - jc);
+    int const sliver_count = (nb + nr - 1) / nr;
+    for (int pc = 0; pc < k; pc += kc) {
+      int const kb = p3a::min(kc, k - pc);
+      T const pass_beta = (pc == 0) ? beta : T(1);
+      for_each(policy,
+          counting_iterator<int>(0),
+          counting_iterator<int>(sliver_count),
+      [=] P3A_HOST_DEVICE (int sliver) P3A_ALWAYS_INLINE {
+        int const jr = sliver * nr;
+        gemm_pack_b_sliver<T, abi_type>(b, pc, kb,
+            jc + jr, p3a::min(nr, nb - jr), b_ptr + std::ptrdiff_t(jr) * kb);
+      });
+      for_each(policy,
+          counting_iterator<int>(0),
+          counting_iterator<int>(block_count),
+      [=] P3A_HOST_DEVICE (int block) P3A_ALWAYS_INLINE {
+        int const ic = block * mc;
+        int const mb = p3a::min(mc, m - ic);
+        if (lower_only && jc > ic + mb - 1) return;
+        T* const block_a = a_ptr + std::ptrdiff_t(ic) * kb;
+        gemm_pack_a<T, abi_type>(a, ic, mb, pc, kb, block_a);
+        T tile[mr * nr];
+        for (int jr = 0; jr < nb; jr += nr) {
+          int const j0 = jc + jr;
+          int const tile_columns = p3a::min(nr, nb - jr);
+          for (int ir = 0; ir < mb; ir += mr) {
+            int const i0 = ic + ir;
+            int const tile_rows = p3a::min(mr, mb - ir);
+            if (lower_only && j0 > i0 + tile_rows - 1) continue;
+            gemm_micro_kernel<T, abi_type>(kb,
+                block_a + std::ptrdiff_t(ir) * kb,
+                b_ptr + std::ptrdiff_t(jr) * kb,
+                tile);
+            for (int i = 0; i < tile_rows; ++i) {
+              // tiles crossing the diagonal must not touch the strict upper triangle
+              int const j_end = lower_only ?
+                p3a::min(tile_columns, i0 + i - j0 + 1) : tile_columns;
+              for (int j = 0; j < j_end; ++j) {
+                T& c_ij = c(i0 + i, j0 + j);
+                c_ij = alpha * tile[i * nr + j] +
+                  ((pass_beta == T(0)) ? T(0) : pass_beta * c_ij);
+              }
+            }
+          }
+        }
+      });
+    }
+  }
+}
+
+// C = alpha * A * B + beta * C, computing only the lower triangle of C if lower_only.
+// C is never read when beta is zero.
+template <class T, class ExecutionPolicy>
+void gemm(
+    T alpha,
+    dynamic_matrix_view<T const, ExecutionPolicy> a,
+    dynamic_matrix_view<T const, ExecutionPolicy> b,
+    T beta,
+    dynamic_matrix_view<T, ExecutionPolicy> c,
+    bool lower_only = false)
+{
+  if (c.row_count() == 0 || c.column_count() == 0) return;
+  if constexpr (is_gpu_policy_v<ExecutionPolicy>) {
+    gemm_direct(alpha, a, b, beta, c, lower_only);
+  } else {
+    using blocking = gemm_blocking<T, typename ExecutionPolicy::simd_abi_type>;
+    double const flops =
+      double(c.row_count()) * double(c.column_count()) * double(a.column_count());
+    if (flops < double(blocking::mc * blocking::nr * blocking::nr)) {
+      gemm_direct(alpha, a, b, beta, c, lower_only);
+    } else {
+      gemm_packed(alpha, a, b, beta, c, lower_only);
+    }
+  }
+}
+
+// y = alpha * A * x + beta * y, with x and y column vectors
+template <class T, class ExecutionPolicy>
+P3A_NEVER_INLINE
+void gemv(
+    T alpha,
+    dynamic_matrix_view<T const, ExecutionPolicy> a,
+    dynamic_matrix_view<T const, ExecutionPolicy> x,
+    T beta,
+    dynamic_matrix_view<T, ExecutionPolicy> y)
+{
+  int const n = a.column_count();
+  for_each(y.get_execution_policy(),
+      counting_iterator<int>(0),
+      counting_iterator<int>(a.row_count()),
+  [=] P3A_HOST_DEVICE (int i) P3A_ALWAYS_INLINE {
+    T sum(0);
+    for (int j = 0; j < n; ++j) {
+      sum += a(i, j) * x(j, 0);
+    }
+    y(i, 0) = alpha * sum + ((beta == T(0)) ? T(0) : beta * y(i, 0));
+  });
+}
+
+}
+
+// C = alpha * A * B + beta * C on views, whose sizes must already match.
+// C must not overlap A or B.
+template <class T, class A, class B, class ExecutionPolicy>
+void gemm(
+    T alpha,
+    dynamic_matrix_view<A, ExecutionPolicy> a,
+    dynamic_matrix_view<B, ExecutionPolicy> b,
+    T beta,
+    dynamic_matrix_view<T, ExecutionPolicy> c)
+{
+  if (a.column_count() != b.row_count()) {
+    throw std::invalid_argument(
+        "dense matrix multiply: LHS columns != RHS rows");
+  }
+  if (c.row_count() != a.row_count() || c.column_count() != b.column_count()) {
+    throw std::invalid_argument(
+        "dense matrix multiply: result wrong size");
   }
+  details::gemm(alpha,
+      dynamic_matrix_view<T const, ExecutionPolicy>(a),
+      dynamic_matrix_view<T const, ExecutionPolicy>(b),
+      beta, c);
 }
 
-template <class T, class Allocator, class ExecutionPolicy>
-P3A_ALWAYS_INLINE inline
+// C = alpha * A * B + beta * C.
+// C is resized if beta is zero, otherwise it must already be the right size.
+template <class T, class Allocator, class ExecutionPolicy, class Layout>
+void gemm(
+    T alpha,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout> const& a,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout> const& b,
+    T beta,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& c)
+{
+  if (beta == T(0)) c.resize(a.row_count(), b.column_count());
+  gemm(alpha, a.view(), b.view(), beta, c.view());
+}
+
+template <class T, class Allocator, class ExecutionPolicy, class Layout>
+void multiply(
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout> const& a,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout> const& b,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& result)
+{
+  gemm(T(1), a, b, T(0), result);
+}
+
+// y = alpha * A * x + beta * y, where x and y are column vectors.
+// y is resized if beta is zero, otherwise it must already be the right size.
+template <class T, class Allocator, class ExecutionPolicy, class Layout>
+void gemv(
+    T alpha,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout> const& a,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout> const& x,
+    T beta,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& y)
+{
+  int const m = a.row_count();
+  int const n = a.column_count();
+  if (x.row_count() != n || x.column_count() != 1) {
+    throw std::invalid_argument(
+        "dense matrix-vector multiply: x wrong size");
+  }
+  if (beta == T(0)) {
+    y.resize(m, 1);
+  } else if (y.row_count() != m || y.column_count() != 1) {
+    throw std::invalid_argument(
+        "dense matrix-vector multiply: y wrong size");
+  }
+  details::gemv(alpha, a.view(), x.view(), beta, y.view());
+}
+
+// symmetric rank-k update C = alpha * A * A^T + beta * C.
+// only the lower triangle is computed, then it is mirrored into the upper one.
+// C is resized if beta is zero, otherwise it must already be the right size.
+template <class T, class Allocator, class ExecutionPolicy, class Layout>
+void rank_k_update(
+    T alpha,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout> const& a,
+    T beta,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& c)
+{
+  int const n = a.row_count();
+  if (beta == T(0)) {
+    c.resize(n, n);
+  } else if (c.row_count() != n || c.column_count() != n) {
+    throw std::invalid_argument(
+        "dense rank-k update: C wrong size");
+  }
+  auto const c_view = c.view();
+  details::gemm(alpha, a.view(), a.view().transpose(), beta, c_view, true);
+  for_each(c.get_execution_policy(),
+      counting_iterator<std::int64_t>(0),
+      counting_iterator<std::int64_t>(std::int64_t(n) * n),
+  [=] P3A_HOST_DEVICE (std::int64_t ij) P3A_ALWAYS_INLINE {
+    int const i = int(ij / n);
+    int const j = int(ij % n);
+    if (j > i) c_view(i, j) = c_view(j, i);
+  });
+}
+
+template <class T, class Allocator, class ExecutionPolicy, class Layout>
 void swap_rows(
-    dynamic_matrix<T, Allocator, ExecutionPolicy>& A,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& A,
     int a, int b)
 {
-  for (int j = 0; j < A.column_count(); ++j) {
-    std::swap(A(a, j), A(b, j));
-  }
+  auto const row_a = A.view().row(a);
+  auto const row_b = A.view().row(b);
+  for_each(A.get_execution_policy(),
+      counting_iterator<int>(0),
+      counting_iterator<int>(A.column_count()),
+  [=] P3A_HOST_DEVICE (int j) P3A_ALWAYS_INLINE {
+    p3a::swap(row_a(0, j), row_b(0, j));
+  });
 }
 
-template <class T, class Allocator, class ExecutionPolicy>
+template <class T, class Allocator, class ExecutionPolicy, class Layout>
 P3A_NEVER_INLINE
 void gaussian_elimination(
-    dynamic_matrix<T, Allocator, ExecutionPolicy>& a,
-    dynamic_matrix<T, Allocator, ExecutionPolicy>& b)
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& a,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& b)
 {
   if (a.row_count() != b.row_count()) {
     throw std::invalid_argument(
@@ -160,11 +666,11 @@ void gaussian_elimination(
   }
 }
 
-template <class T, class Allocator, class ExecutionPolicy>
+template <class T, class Allocator, class ExecutionPolicy, class Layout>
 void back_substitution(
-    dynamic_matrix<T, Allocator, ExecutionPolicy> const& U,
-    dynamic_matrix<T, Allocator, ExecutionPolicy> const& y,
-    dynamic_matrix<T, Allocator, ExecutionPolicy>& x) {
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout> const& U,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout> const& y,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& x) {
   if (U.row_count() != U.column_count()) {
     throw std::invalid_argument(
         "back substitution: U not square");
@@ -191,11 +697,11 @@ void back_substitution(
   }
 }
 
-template <class T, class Allocator, class ExecutionPolicy>
+template <class T, class Allocator, class ExecutionPolicy, class Layout>
 void solve(
-    dynamic_matrix<T, Allocator, ExecutionPolicy>& a,
-    dynamic_matrix<T, Allocator, ExecutionPolicy>& b,
-    dynamic_matrix<T, Allocator, ExecutionPolicy>& x)
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& a,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& b,
+    dynamic_matrix<T, Allocator, ExecutionPolicy, Layout>& x)
 {
   if (a.row_count() != b.row_count()) {
     throw std::invalid_argument(
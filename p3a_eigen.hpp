@@ -122,31 +122,190 @@ void rotate_givens_right(
   }
 }
 
+/* Jacobi eigensolvers for symmetric static_matrix.
+   Rather than searching for the largest off-diagonal entry before every
+   rotation, which costs O(N^2) per rotation, these visit every pair once per
+   sweep and check convergence once per sweep.
+   Rotations whose entry is already below a threshold are skipped: during the
+   first sweeps the threshold is Rutishauser's fraction of the off-diagonal
+   norm, afterwards it is small enough that skipping every rotation implies
+   convergence.
+   Rotation angles are computed without branching on data, so T may be a
+   SIMD type with one matrix per lane; a sweep continues until every lane
+   has converged. */
+
+namespace details {
+
+// symmetric_schur without branches; the rotation is the identity where skip is true
+template <class T, class Mask>
+P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+void masked_symmetric_schur(
+    T const& f,
+    T const& g,
+    T const& h,
+    Mask const& skip,
+    T& c,
+    T& s)
+{
+  auto const is_identity = skip || (g == T(0));
+  T const t0 = (h - f) / (T(2) * condition(is_identity, T(1), g));
+  T const root = p3a::sqrt(T(1) + square(t0));
+  T t = condition(t0 >= T(0), T(1) / (root + t0), T(-1) / (root - t0));
+  t = condition(is_identity, T(0), t);
+  c = T(1) / p3a::sqrt(T(1) + square(t));
+  s = t * c;
+}
+
+template <class T>
+P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+T jacobi_threshold(
+    int const n,
+    T const& off_diagonal,
+    T const& tolerance,
+    int const sweep)
+{
+  // if every off-diagonal entry is below tolerance / n then the
+  // off-diagonal norm is below tolerance
+  T const threshold = tolerance / T(n);
+  if (sweep >= 3) return threshold;
+  return p3a::max(threshold, T(0.2) * off_diagonal / T(n * n));
+}
+
+inline constexpr int jacobi_maximum_sweep_count = 20;
+
+// the cyclic sweeps for any n x n matrix type with operator()(i, j),
+// so that static and dynamic matrices share one implementation.
+// q must hold the identity (or a basis to accumulate into) on entry.
+template <class T, class Matrix>
+P3A_HOST_DEVICE inline
+void cyclic_jacobi_sweeps(
+    Matrix& a,
+    Matrix& q,
+    int const n,
+    T const& tolerance)
+{
+  for (int sweep = 0; sweep < jacobi_maximum_sweep_count; ++sweep) {
+    T odn(0);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        if (i != j) odn += square(a(i, j));
+      }
+    }
+    odn = p3a::sqrt(odn);
+    if (all_of(odn <= tolerance)) break;
+    T const threshold = jacobi_threshold(n, odn, tolerance, sweep);
+    for (int i = 0; i < n - 1; ++i) {
+      for (int j = i + 1; j < n; ++j) {
+        auto const skip = (p3a::abs(a(i, j)) <= threshold);
+        if (all_of(skip)) continue;
+        T c, s;
+        masked_symmetric_schur(T(a(i, i)), T(a(i, j)), T(a(j, j)), skip, c, s);
+        for (int k = 0; k < n; ++k) {
+          T const t1 = a(i, k);
+          T const t2 = a(j, k);
+          a(i, k) = c * t1 - s * t2;
+          a(j, k) = s * t1 + c * t2;
+        }
+        for (int k = 0; k < n; ++k) {
+          T const t1 = a(k, i);
+          T const t2 = a(k, j);
+          a(k, i) = c * t1 - s * t2;
+          a(k, j) = s * t1 + c * t2;
+        }
+        for (int k = 0; k < n; ++k) {
+          T const t1 = q(k, i);
+          T const t2 = q(k, j);
+          q(k, i) = c * t1 - s * t2;
+          q(k, j) = s * t1 + c * t2;
+        }
+      }
+    }
+  }
+}
+
+}
+
+// cyclic-by-row Jacobi: pairs (i, j) are visited in row order
 template <class T, int N>
 P3A_HOST_DEVICE inline
-void eigendecompose(
+void cyclic_jacobi_eigendecompose(
     static_matrix<T, N, N>& a,
     static_matrix<T, N, N>& q,
     T const& tolerance)
 {
   q.assign_identity();
-  int constexpr maximum_iteration_count = (5 * N * N) / 2;
-  for (int iteration = 0; iteration < maximum_iteration_count; ++iteration) {
+  details::cyclic_jacobi_sweeps(a, q, N, tolerance);
+}
+
+// parallel (round-robin) ordering: each sweep is N - 1 rounds (N if N is odd)
+// of up to N / 2 rotations acting on disjoint rows and columns.
+// the angles of a round only depend on the matrix before it, so they are all
+// computed first and the rotations are then applied without dependencies
+// between them.
+template <class T, int N>
+P3A_HOST_DEVICE inline
+void parallel_jacobi_eigendecompose(
+    static_matrix<T, N, N>& a,
+    static_matrix<T, N, N>& q,
+    T const& tolerance)
+{
+  // an odd N gets a dummy index N, whose partner sits out that round
+  int constexpr player_count = N + N % 2;
+  int constexpr pair_count = player_count / 2;
+  q.assign_identity();
+  for (int sweep = 0; sweep < details::jacobi_maximum_sweep_count; ++sweep) {
     T const odn = off_diagonal_norm(a);
-    if (odn <= tolerance) break;
-    int i, j;
-    maximum_off_diagonal_indices(a, i, j);
-    T const f = a(i, i);
-    T const g = a(i, j);
-    T const h = a(j, j);
-    T c, s;
-    symmetric_schur(f, g, h, c, s);
-    rotate_givens_left(c, s, i, j, a);
-    rotate_givens_right(c, s, i, j, a);
-    rotate_givens_right(c, s, i, j, q);
+    if (all_of(odn <= tolerance)) break;
+    T const threshold = details::jacobi_threshold(N, odn, tolerance, sweep);
+    for (int round = 0; round < player_count - 1; ++round) {
+      int first[pair_count];
+      int second[pair_count];
+      T c[pair_count];
+      T s[pair_count];
+      bool is_active[pair_count];
+      bool any_active = false;
+      for (int k = 0; k < pair_count; ++k) {
+        // circle method: index 0 stays fixed and the others rotate
+        int const i = (k == 0) ? 0 : ((k + round - 1) % (player_count - 1) + 1);
+        int const j = (player_count - 2 - k + round) % (player_count - 1) + 1;
+        first[k] = p3a::min(i, j);
+        second[k] = p3a::max(i, j);
+        is_active[k] = false;
+        if (second[k] == N) continue;
+        auto const skip = (p3a::abs(a(first[k], second[k])) <= threshold);
+        if (all_of(skip)) continue;
+        details::masked_symmetric_schur(
+            a(first[k], first[k]), a(first[k], second[k]), a(second[k], second[k]),
+            skip, c[k], s[k]);
+        is_active[k] = true;
+        any_active = true;
+      }
+      if (!any_active) continue;
+      for (int k = 0; k < pair_count; ++k) {
+        if (is_active[k]) rotate_givens_left(c[k], s[k], first[k], second[k], a);
+      }
+      for (int k = 0; k < pair_count; ++k) {
+        if (is_active[k]) {
+          rotate_givens_right(c[k], s[k], first[k], second[k], a);
+          rotate_givens_right(c[k], s[k], first[k], second[k], q);
+        }
+      }
+    }
   }
 }
 
+// on return the diagonal of a holds the eigenvalues and
+// the columns of q hold the eigenvectors
+template <class T, int N>
+P3A_HOST_DEVICE inline
+void eigendecompose(
+    static_matrix<T, N, N>& a,
+    static_matrix<T, N, N>& q,
+    T const& tolerance)
+{
+  cyclic_jacobi_eigendecompose(a, q, tolerance);
+}
+
 template <class T, int N>
 P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
 T eigen_tolerance(
@@ -166,6 +325,169 @@ void eigendecompose(
   eigendecompose(a, q, eigen_tolerance(a));
 }
 
+/* Closed-form eigensolver for symmetric 3x3 matrices.
+   Eigenvalues come from the trigonometric solution of the characteristic
+   cubic (Smith, CACM 4(4), 1961) and eigenvectors from cross products of
+   rows of A - lambda I, starting with the eigenvalue that is farthest from
+   the other two (Eberly, "A Robust Eigensolver for 3x3 Symmetric Matrices").
+   The second eigenvector is found within the plane orthogonal to the first,
+   which stays well defined when the other two eigenvalues coincide, and the
+   third is their cross product.
+   There are no data-dependent branches, so T may be a SIMD type,
+   and the cost is fixed rather than depending on Jacobi convergence. */
+
+namespace details {
+
+// unit eigenvector of a for a simple eigenvalue lambda:
+// the rows of a - lambda I span the plane orthogonal to it,
+// so the largest cross product of two rows is used.
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+vector3<T> simple_eigenvector(
+    symmetric3x3<T> const& a,
+    T const& lambda)
+{
+  vector3<T> const r0(a.xx() - lambda, a.xy(), a.xz());
+  vector3<T> const r1(a.xy(), a.yy() - lambda, a.yz());
+  vector3<T> const r2(a.xz(), a.yz(), a.zz() - lambda);
+  vector3<T> v = cross_product(r0, r1);
+  T d = magnitude_squared(v);
+  vector3<T> const v02 = cross_product(r0, r2);
+  T const d02 = magnitude_squared(v02);
+  auto const use_02 = (d02 > d);
+  v = condition(use_02, v02, v);
+  d = condition(use_02, d02, d);
+  vector3<T> const v12 = cross_product(r1, r2);
+  T const d12 = magnitude_squared(v12);
+  auto const use_12 = (d12 > d);
+  v = condition(use_12, v12, v);
+  d = condition(use_12, d12, d);
+  // lambda was not simple after all, any direction will do
+  auto const is_degenerate = (d == T(0));
+  v = condition(is_degenerate, vector3<T>(T(1), T(0), T(0)), v);
+  d = condition(is_degenerate, T(1), d);
+  return v / p3a::sqrt(d);
+}
+
+// unit eigenvector of a for the eigenvalue lambda that is
+// orthogonal to the unit eigenvector w
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+vector3<T> orthogonal_eigenvector(
+    symmetric3x3<T> const& a,
+    vector3<T> const& w,
+    T const& lambda)
+{
+  // orthonormal basis {u, v} of the plane orthogonal to w
+  auto const use_x = (p3a::abs(w.x()) > p3a::abs(w.y()));
+  vector3<T> u(
+      condition(use_x, -w.z(), T(0)),
+      condition(use_x, T(0), w.z()),
+      condition(use_x, w.x(), -w.y()));
+  u = u / p3a::sqrt(magnitude_squared(u));
+  vector3<T> const v = cross_product(w, u);
+  // a - lambda I restricted to that plane is a singular 2x2 matrix;
+  // its larger row is orthogonal to the eigenvector
+  vector3<T> const au = a * u;
+  vector3<T> const av = a * v;
+  T const m00 = dot_product(u, au) - lambda;
+  T const m01 = dot_product(u, av);
+  T const m11 = dot_product(v, av) - lambda;
+  auto const use_first_row = (p3a::abs(m00) >= p3a::abs(m11));
+  T x = condition(use_first_row, m00, m01);
+  T y = condition(use_first_row, m01, m11);
+  T const scale = p3a::max(p3a::abs(x), p3a::abs(y));
+  // the restricted matrix is zero when lambda is a double eigenvalue,
+  // in which case every direction in the plane is an eigenvector
+  auto const is_degenerate = (scale == T(0));
+  T const inverse_scale = T(1) / condition(is_degenerate, T(1), scale);
+  x = condition(is_degenerate, T(0), x * inverse_scale);
+  y = condition(is_degenerate, T(1), y * inverse_scale);
+  T const inverse_length = T(1) / p3a::sqrt(square(x) + square(y));
+  return (y * inverse_length) * u - (x * inverse_length) * v;
+}
+
+// eigenvalues in descending order of a matrix whose entries are at most one
+// in magnitude, along with the values needed to compute its eigenvectors
+template <class T>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void scaled_eigenvalues(
+    symmetric3x3<T> const& a,
+    diagonal3x3<T>& l,
+    T& half_determinant,
+    T& deviation)
+{
+  T const mean = trace(a) / T(3);
+  T const off_diagonal = square(a.xy()) + square(a.xz()) + square(a.yz());
+  T const b_xx = a.xx() - mean;
+  T const b_yy = a.yy() - mean;
+  T const b_zz = a.zz() - mean;
+  deviation = p3a::sqrt(
+      (square(b_xx) + square(b_yy) + square(b_zz) + T(2) * off_diagonal) / T(6));
+  // the eigenvalues of B = (A - mean I) / deviation are 2 cos(phi + 2 pi k / 3)
+  // with cos(3 phi) = det(B) / 2
+  T const inverse_deviation = T(1) / condition(deviation == T(0), T(1), deviation);
+  symmetric3x3<T> const b(
+      b_xx * inverse_deviation, a.xy() * inverse_deviation, a.xz() * inverse_deviation,
+      b_yy * inverse_deviation, a.yz() * inverse_deviation, b_zz * inverse_deviation);
+  half_determinant = p3a::min(p3a::max(determinant(b) / T(2), T(-1)), T(1));
+  T const phi = p3a::acos(half_determinant) / T(3);
+  T const beta_largest = T(2) * p3a::cos(phi);
+  T const beta_smallest = T(2) * p3a::cos(phi + T(2) * pi_value<T>() / T(3));
+  T const beta_middle = -(beta_largest + beta_smallest);
+  l = diagonal3x3<T>(
+      mean + deviation * beta_largest,
+      mean + deviation * beta_middle,
+      mean + deviation * beta_smallest);
+}
+
+// puts the larger eigenvalue first
+template <class T>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void sort_eigenpair(
+    T& lambda_a,
+    vector3<T>& v_a,
+    T& lambda_b,
+    vector3<T>& v_b)
+{
+  auto const is_out_of_order = (lambda_b > lambda_a);
+  T const old_lambda_a = lambda_a;
+  vector3<T> const old_v_a = v_a;
+  lambda_a = condition(is_out_of_order, lambda_b, lambda_a);
+  lambda_b = condition(is_out_of_order, old_lambda_a, lambda_b);
+  v_a = condition(is_out_of_order, v_b, v_a);
+  v_b = condition(is_out_of_order, -old_v_a, v_b);
+}
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+T eigen_scale(symmetric3x3<T> const& a)
+{
+  T const max_entry = maximum_norm(a);
+  return condition(max_entry == T(0), T(1), max_entry);
+}
+
+}
+
+// eigenvalues of a in descending order.
+// near a repeated eigenvalue these are only accurate to about
+// sqrt(epsilon) relative to the largest entry of a;
+// eigendecompose() refines them to about epsilon.
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE inline
+diagonal3x3<T> eigenvalues(symmetric3x3<T> const& a)
+{
+  // scaling avoids overflow and underflow in the squares and cubes below
+  T const scale = details::eigen_scale(a);
+  symmetric3x3<T> const b = a / scale;
+  diagonal3x3<T> l;
+  T half_determinant, deviation;
+  details::scaled_eigenvalues(b, l, half_determinant, deviation);
+  return diagonal3x3<T>(l.xx() * scale, l.yy() * scale, l.zz() * scale);
+}
+
+// a = q l q^T with the eigenvalues in l in descending order
+// and the eigenvectors in the columns of q, which is a rotation
 template <class T>
 P3A_HOST_DEVICE inline
 void eigendecompose(
@@ -173,13 +495,44 @@ void eigendecompose(
     diagonal3x3<T>& l,
     matrix3x3<T>& q)
 {
-  static_matrix<T, 3, 3> a2(a);
-  static_matrix<T, 3, 3> q2;
-  eigendecompose(a2, q2);
-  l.xx() = a2(0, 0);
-  l.yy() = a2(1, 1);
-  l.zz() = a2(2, 2);
-  q = static_cast<matrix3x3<T>>(q2);
+  T const scale = details::eigen_scale(a);
+  symmetric3x3<T> const b = a / scale;
+  T half_determinant, deviation;
+  details::scaled_eigenvalues(b, l, half_determinant, deviation);
+  // the largest eigenvalue is the farthest from the others if det(B) >= 0,
+  // otherwise the smallest one is
+  auto const largest_first = (half_determinant >= T(0));
+  T const lambda_first = condition(largest_first, l.xx(), l.zz());
+  vector3<T> const v_first = details::simple_eigenvector(b, lambda_first);
+  vector3<T> const v_middle = details::orthogonal_eigenvector(b, v_first, l.yy());
+  vector3<T> const v_last = cross_product(v_first, v_middle);
+  // a multiple of the identity gets the identity as its eigenvectors
+  auto const is_isotropic = (deviation == T(0));
+  vector3<T> column_0 = condition(is_isotropic,
+      vector3<T>(T(1), T(0), T(0)),
+      condition(largest_first, v_first, -v_last));
+  vector3<T> column_1 = condition(is_isotropic,
+      vector3<T>(T(0), T(1), T(0)),
+      v_middle);
+  vector3<T> column_2 = condition(is_isotropic,
+      vector3<T>(T(0), T(0), T(1)),
+      condition(largest_first, v_last, v_first));
+  // the trigonometric eigenvalues are only accurate to about sqrt(epsilon)
+  // near a repeated eigenvalue, where acos is ill-conditioned, while the
+  // Rayleigh quotients of the eigenvectors are accurate to about epsilon
+  T lambda_0 = dot_product(column_0, b * column_0);
+  T lambda_1 = dot_product(column_1, b * column_1);
+  T lambda_2 = dot_product(column_2, b * column_2);
+  // that can reorder nearly equal eigenvalues, so sort them again;
+  // negating a swapped column keeps q a rotation
+  details::sort_eigenpair(lambda_0, column_0, lambda_1, column_1);
+  details::sort_eigenpair(lambda_1, column_1, lambda_2, column_2);
+  details::sort_eigenpair(lambda_0, column_0, lambda_1, column_1);
+  q = matrix3x3<T>(
+      column_0.x(), column_1.x(), column_2.x(),
+      column_0.y(), column_1.y(), column_2.y(),
+      column_0.z(), column_1.z(), column_2.z());
+  l = diagonal3x3<T>(lambda_0 * scale, lambda_1 * scale, lambda_2 * scale);
 }
 
 }
@@ -4,6 +4,9 @@
 
 #include "p3a_matrix3x3.hpp"
 #include "p3a_tensor_detail.hpp"
+#include "p3a_static_matrix.hpp"
+#include "p3a_mandel6x6.hpp"
+#include "p3a_tensor_expression.hpp"
 
 namespace p3a {
 
@@ -62,63 +65,341 @@ binary_powering(matrix3x3<T> const& A, int const e)
   return X;
 }
 
+namespace details {
+
+// Padé approximant odd and even terms of order 3, 5, 7 or 9 built from
+// precomputed even powers, even_powers[k] = A^(2k)
+template <typename T>
+P3A_HOST_DEVICE inline void
+pade_terms_from_powers(
+    matrix3x3<T> const& A,
+    matrix3x3<T> const* even_powers,
+    int const order,
+    matrix3x3<T>& U,
+    matrix3x3<T>& V)
+{
+  using scalar_type = scalar_type_t<T>;
+  U = polynomial_coefficient<scalar_type>(order, 1) * even_powers[0];
+  V = polynomial_coefficient<scalar_type>(order, 0) * even_powers[0];
+  for (int i = 3; i <= order; i += 2) {
+    U += polynomial_coefficient<scalar_type>(order, i) * even_powers[i / 2];
+    V += polynomial_coefficient<scalar_type>(order, i - 1) * even_powers[i / 2];
+  }
+  U = A * U;
+}
+
+// lanes above the highest order's theta are scaled by 2^-s with
+// s = ceil(log2(norm / theta)), found by halving to stay branch-free
+template <typename T>
+P3A_HOST_DEVICE inline void
+exp_scaling(T const& norm, T& scale, T& squaring_count)
+{
+  using scalar_type        = scalar_type_t<T>;
+  auto const theta_highest = T(scaling_squaring_theta<scalar_type>(13));
+  T          scaled_norm   = norm;
+  scale                    = T(1);
+  squaring_count           = T(0);
+  for (int j = 0; j < 64; ++j) {
+    auto const is_too_large = (scaled_norm > theta_highest);
+    if (none_of(is_too_large)) break;
+    scaled_norm    = condition(is_too_large, T(0.5) * scaled_norm, scaled_norm);
+    scale          = condition(is_too_large, T(0.5) * scale, scale);
+    squaring_count = condition(is_too_large, squaring_count + T(1), squaring_count);
+  }
+}
+
+}
+
 // Exponential map by squaring and scaling and Padé approximants.
 // See algorithm 10.20 in Functions of Matrices, N.J. Higham, SIAM, 2008.
+// T may be a SIMD type, in which case the Padé order and the number of
+// squarings are chosen per lane and the even powers of A are shared by
+// all orders, so each power is formed at most once per call.
 template <typename T>
 [[nodiscard]] P3A_HOST_DEVICE inline auto
 exp(matrix3x3<T> const& A)
 {
-  auto       B             = matrix3x3<T>::identity();
-  int const  orders[]      = {3, 5, 7, 9, 13};
-  auto const number_orders = 5;
-  auto const highest_order = orders[number_orders - 1];
-  auto const norm          = norm_1(A);
-  for (auto i = 0; i < number_orders; ++i) {
-    auto const order = orders[i];
-    auto const theta = scaling_squaring_theta<T>(order);
-    if (order < highest_order && norm < theta) {
-      auto U = B;
-      auto V = B;
-      pade_polynomial_terms(A, order, U, V);
-      B = inverse(V - U) * (U + V);
-      break;
-    } else if (order == highest_order) {
-      auto const theta_highest = scaling_squaring_theta<T>(order);
-      auto const signed_power  = static_cast<int>(std::ceil(std::log2(norm / theta_highest)));
-      auto const power_two     = signed_power > 0 ? static_cast<int>(signed_power) : 0;
-      auto       scale         = 1.0;
-      for (int j = 0; j < power_two; ++j) {
-        scale /= 2.0;
+  using scalar_type = scalar_type_t<T>;
+  using mask_type   = decltype(T() < T());
+  auto const I      = matrix3x3<T>::identity();
+  auto const norm   = norm_1(A);
+  T          scale;
+  T          squaring_count;
+  details::exp_scaling(norm, scale, squaring_count);
+  // scale is exactly one in every lane that uses a low order
+  matrix3x3<T> powers[5];
+  auto const A1 = scale * A;
+  powers[0]     = I;
+  powers[1]     = A1 * A1;
+  powers[2]     = powers[1] * powers[1];
+  powers[3]     = powers[1] * powers[2];
+  auto U        = matrix3x3<T>::zero();
+  auto V        = matrix3x3<T>::zero();
+  mask_type is_chosen(false);
+  int const low_orders[] = {3, 5, 7, 9};
+  for (int const order : low_orders) {
+    auto const theta  = T(scaling_squaring_theta<scalar_type>(order));
+    auto const is_new = (!is_chosen) && (norm < theta);
+    if (any_of(is_new)) {
+      if (order == 9) powers[4] = powers[2] * powers[2];
+      matrix3x3<T> U_order;
+      matrix3x3<T> V_order;
+      details::pade_terms_from_powers(A1, powers, order, U_order, V_order);
+      U = condition(is_new, U_order, U);
+      V = condition(is_new, V_order, V);
+    }
+    is_chosen = is_chosen || is_new;
+  }
+  if (!all_of(is_chosen)) {
+    auto const& A2  = powers[1];
+    auto const& A4  = powers[2];
+    auto const& A6  = powers[3];
+    auto const  b0  = polynomial_coefficient<scalar_type>(13, 0);
+    auto const  b1  = polynomial_coefficient<scalar_type>(13, 1);
+    auto const  b2  = polynomial_coefficient<scalar_type>(13, 2);
+    auto const  b3  = polynomial_coefficient<scalar_type>(13, 3);
+    auto const  b4  = polynomial_coefficient<scalar_type>(13, 4);
+    auto const  b5  = polynomial_coefficient<scalar_type>(13, 5);
+    auto const  b6  = polynomial_coefficient<scalar_type>(13, 6);
+    auto const  b7  = polynomial_coefficient<scalar_type>(13, 7);
+    auto const  b8  = polynomial_coefficient<scalar_type>(13, 8);
+    auto const  b9  = polynomial_coefficient<scalar_type>(13, 9);
+    auto const  b10 = polynomial_coefficient<scalar_type>(13, 10);
+    auto const  b11 = polynomial_coefficient<scalar_type>(13, 11);
+    auto const  b12 = polynomial_coefficient<scalar_type>(13, 12);
+    auto const  b13 = polynomial_coefficient<scalar_type>(13, 13);
+    auto const  W13 = evaluate(b13 * lazy(A6) + b11 * lazy(A4) + b9 * lazy(A2));
+    auto const  Z13 = evaluate(b12 * lazy(A6) + b10 * lazy(A4) + b8 * lazy(A2));
+    auto const  U13 = A1 * evaluate(lazy(A6 * W13) + b7 * lazy(A6) + b5 * lazy(A4) + b3 * lazy(A2) + b1 * lazy(I));
+    auto const  V13 = evaluate(lazy(A6 * Z13) + b6 * lazy(A6) + b4 * lazy(A4) + b2 * lazy(A2) + b0 * lazy(I));
+    U               = condition(is_chosen, U, U13);
+    V               = condition(is_chosen, V, V13);
+  }
+  auto B = inverse(V - U) * (U + V);
+  for (int j = 0; j < 64; ++j) {
+    auto const is_squaring = (T(scalar_type(j)) < squaring_count);
+    if (none_of(is_squaring)) break;
+    B = condition(is_squaring, B * B, B);
+  }
+  return B;
+}
+
+namespace details {
+
+// exp(A) and its Fréchet derivatives L(A, E[d]) in N directions at once, by
+// the scaling and squaring algorithm of Al-Mohy and Higham, SIAM J. Matrix
+// Anal. Appl. 30(4), 2009, also algorithm 10.27 in Functions of Matrices.
+// The order and scaling are chosen per lane exactly as in exp(), and the
+// powers of A and the inverse of V - U are shared by all directions.
+template <typename T, int N>
+P3A_HOST_DEVICE inline void
+exp_frechet_directions(
+    matrix3x3<T> const& A,
+    matrix3x3<T> const (&E)[N],
+    matrix3x3<T>& X,
+    matrix3x3<T> (&L)[N])
+{
+  using scalar_type = scalar_type_t<T>;
+  using mask_type   = decltype(T() < T());
+  auto const I      = matrix3x3<T>::identity();
+  auto const norm   = norm_1(A);
+  T          scale;
+  T          squaring_count;
+  exp_scaling(norm, scale, squaring_count);
+  // powers[k] = A1^(2k) and M[d][k] is its derivative in direction E1[d]
+  matrix3x3<T> powers[5];
+  matrix3x3<T> E1[N];
+  matrix3x3<T> M[N][5];
+  auto const   A1 = scale * A;
+  powers[0]       = I;
+  powers[1]       = A1 * A1;
+  powers[2]       = powers[1] * powers[1];
+  powers[3]       = powers[1] * powers[2];
+  for (int d = 0; d < N; ++d) {
+    E1[d]   = scale * E[d];
+    M[d][1] = A1 * E1[d] + E1[d] * A1;
+    M[d][2] = powers[1] * M[d][1] + M[d][1] * powers[1];
+    M[d][3] = powers[2] * M[d][1] + M[d][2] * powers[1];
+  }
+  auto         U = matrix3x3<T>::zero();
+  auto         V = matrix3x3<T>::zero();
+  matrix3x3<T> L_U[N];
+  matrix3x3<T> L_V[N];
+  for (int d = 0; d < N; ++d) {
+    L_U[d] = matrix3x3<T>::zero();
+    L_V[d] = matrix3x3<T>::zero();
+  }
+  mask_type is_chosen(false);
+  int const low_orders[] = {3, 5, 7, 9};
+  for (int const order : low_orders) {
+    auto const theta  = T(scaling_squaring_theta<scalar_type>(order));
+    auto const is_new = (!is_chosen) && (norm < theta);
+    if (any_of(is_new)) {
+      if (order == 9) {
+        powers[4] = powers[2] * powers[2];
+        for (int d = 0; d < N; ++d) {
+          M[d][4] = powers[2] * M[d][2] + M[d][2] * powers[2];
+        }
+      }
+      auto W_order = polynomial_coefficient<scalar_type>(order, 1) * I;
+      auto V_order = polynomial_coefficient<scalar_type>(order, 0) * I;
+      for (int i = 3; i <= order; i += 2) {
+        W_order += polynomial_coefficient<scalar_type>(order, i) * powers[i / 2];
+        V_order += polynomial_coefficient<scalar_type>(order, i - 1) * powers[i / 2];
       }
-      auto const I        = matrix3x3<T>::identity();
-      auto const A1       = scale * A;
-      auto const A2       = A1 * A1;
-      auto const A4       = A2 * A2;
-      auto const A6       = A2 * A4;
-      auto const b0       = polynomial_coefficient<T>(order, 0);
-      auto const b1       = polynomial_coefficient<T>(order, 1);
-      auto const b2       = polynomial_coefficient<T>(order, 2);
-      auto const b3       = polynomial_coefficient<T>(order, 3);
-      auto const b4       = polynomial_coefficient<T>(order, 4);
-      auto const b5       = polynomial_coefficient<T>(order, 5);
-      auto const b6       = polynomial_coefficient<T>(order, 6);
-      auto const b7       = polynomial_coefficient<T>(order, 7);
-      auto const b8       = polynomial_coefficient<T>(order, 8);
-      auto const b9       = polynomial_coefficient<T>(order, 9);
-      auto const b10      = polynomial_coefficient<T>(order, 10);
-      auto const b11      = polynomial_coefficient<T>(order, 11);
-      auto const b12      = polynomial_coefficient<T>(order, 12);
-      auto const b13      = polynomial_coefficient<T>(order, 13);
-      auto const U        = A1 * ((A6 * (b13 * A6 + b11 * A4 + b9 * A2) + b7 * A6 + b5 * A4 + b3 * A2 + b1 * I));
-      auto const V        = A6 * (b12 * A6 + b10 * A4 + b8 * A2) + b6 * A6 + b4 * A4 + b2 * A2 + b0 * I;
-      auto const R        = inverse(V - U) * (U + V);
-      auto const exponent = (1 << power_two);
-      B                   = binary_powering(R, exponent);
+      U = condition(is_new, A1 * W_order, U);
+      V = condition(is_new, V_order, V);
+      for (int d = 0; d < N; ++d) {
+        auto L_W       = matrix3x3<T>::zero();
+        auto L_V_order = matrix3x3<T>::zero();
+        for (int i = 3; i <= order; i += 2) {
+          L_W += polynomial_coefficient<scalar_type>(order, i) * M[d][i / 2];
+          L_V_order += polynomial_coefficient<scalar_type>(order, i - 1) * M[d][i / 2];
+        }
+        L_U[d] = condition(is_new, A1 * L_W + E1[d] * W_order, L_U[d]);
+        L_V[d] = condition(is_new, L_V_order, L_V[d]);
+      }
+    }
+    is_chosen = is_chosen || is_new;
+  }
+  if (!all_of(is_chosen)) {
+    auto const& A2 = powers[1];
+    auto const& A4 = powers[2];
+    auto const& A6 = powers[3];
+    scalar_type b[14];
+    for (int i = 0; i < 14; ++i) b[i] = polynomial_coefficient<scalar_type>(13, i);
+    auto const W1 = evaluate(b[13] * lazy(A6) + b[11] * lazy(A4) + b[9] * lazy(A2));
+    auto const W2 = evaluate(b[7] * lazy(A6) + b[5] * lazy(A4) + b[3] * lazy(A2) + b[1] * lazy(I));
+    auto const Z1 = evaluate(b[12] * lazy(A6) + b[10] * lazy(A4) + b[8] * lazy(A2));
+    auto const Z2 = evaluate(b[6] * lazy(A6) + b[4] * lazy(A4) + b[2] * lazy(A2) + b[0] * lazy(I));
+    auto const W  = evaluate(lazy(A6 * W1) + W2);
+    U             = condition(is_chosen, U, A1 * W);
+    V             = condition(is_chosen, V, evaluate(lazy(A6 * Z1) + Z2));
+    for (int d = 0; d < N; ++d) {
+      auto const& M2   = M[d][1];
+      auto const& M4   = M[d][2];
+      auto const& M6   = M[d][3];
+      auto const  L_W1 = evaluate(b[13] * lazy(M6) + b[11] * lazy(M4) + b[9] * lazy(M2));
+      auto const  L_W2 = evaluate(b[7] * lazy(M6) + b[5] * lazy(M4) + b[3] * lazy(M2));
+      auto const  L_Z1 = evaluate(b[12] * lazy(M6) + b[10] * lazy(M4) + b[8] * lazy(M2));
+      auto const  L_Z2 = evaluate(b[6] * lazy(M6) + b[4] * lazy(M4) + b[2] * lazy(M2));
+      auto const  L_W  = evaluate(lazy(A6 * L_W1) + M6 * W1 + L_W2);
+      L_U[d]           = condition(is_chosen, L_U[d], A1 * L_W + E1[d] * W);
+      L_V[d]           = condition(is_chosen, L_V[d], evaluate(lazy(A6 * L_Z1) + M6 * Z1 + L_Z2));
+    }
+  }
+  auto const P_inverse = inverse(V - U);
+  X                    = P_inverse * (U + V);
+  for (int d = 0; d < N; ++d) {
+    L[d] = P_inverse * (L_U[d] + L_V[d] + (L_U[d] - L_V[d]) * X);
+  }
+  for (int j = 0; j < 64; ++j) {
+    auto const is_squaring = (T(scalar_type(j)) < squaring_count);
+    if (none_of(is_squaring)) break;
+    for (int d = 0; d < N; ++d) {
+      L[d] = condition(is_squaring, X * L[d] + L[d] * X, L[d]);
     }
+    X = condition(is_squaring, X * X, X);
+  }
+}
+
+// orthonormal basis of symmetric tensors in Mandel order xx, yy, zz, yz, xz, xy
+template <typename T>
+[[nodiscard]] P3A_HOST_DEVICE inline auto
+mandel_basis(int const j)
+{
+  auto       B = matrix3x3<T>::zero();
+  auto const c = T(1.0 / square_root_of_two_value<scalar_type_t<T>>());
+  switch (j) {
+    case 0: B(0, 0) = T(1); break;
+    case 1: B(1, 1) = T(1); break;
+    case 2: B(2, 2) = T(1); break;
+    case 3: B(1, 2) = B(2, 1) = c; break;
+    case 4: B(0, 2) = B(2, 0) = c; break;
+    case 5: B(0, 1) = B(1, 0) = c; break;
   }
   return B;
 }
 
+// component of a symmetric tensor along mandel_basis(i)
+template <typename T>
+[[nodiscard]] P3A_HOST_DEVICE inline auto
+mandel_component(matrix3x3<T> const& S, int const i)
+{
+  auto const c = T(0.5 * square_root_of_two_value<scalar_type_t<T>>());
+  switch (i) {
+    case 0: return S(0, 0);
+    case 1: return S(1, 1);
+    case 2: return S(2, 2);
+    case 3: return T(c * (S(1, 2) + S(2, 1)));
+    case 4: return T(c * (S(0, 2) + S(2, 0)));
+    default: return T(c * (S(0, 1) + S(1, 0)));
+  }
+}
+
+// derivative of exp at symmetric A restricted to symmetric directions,
+// as a 6x6 matrix in the orthonormal Mandel basis
+template <typename T>
+[[nodiscard]] P3A_HOST_DEVICE inline auto
+exp_tangent_mandel_matrix(matrix3x3<T> const& A)
+{
+  matrix3x3<T> E[6];
+  for (int j = 0; j < 6; ++j) E[j] = mandel_basis<T>(j);
+  matrix3x3<T> X;
+  matrix3x3<T> L[6];
+  exp_frechet_directions(A, E, X, L);
+  static_matrix<T, 6, 6> J;
+  for (int i = 0; i < 6; ++i) {
+    for (int j = 0; j < 6; ++j) J(i, j) = mandel_component(L[j], i);
+  }
+  return J;
+}
+
+}
+
+// Fréchet derivative of the exponential map at A in the direction E,
+// the exact directional derivative of exp() with no finite differencing
+template <typename T>
+[[nodiscard]] P3A_HOST_DEVICE inline auto
+exp_frechet(matrix3x3<T> const& A, matrix3x3<T> const& E)
+{
+  matrix3x3<T> const directions[1] = {E};
+  matrix3x3<T>       X;
+  matrix3x3<T>       L[1];
+  details::exp_frechet_directions(A, directions, X, L);
+  return L[0];
+}
+
+// Derivative of the exponential map d exp(A)_ij / d A_kl as a 9x9 matrix
+// with row 3i+j and column 3k+l, computed with one shared scaling and squaring
+template <typename T>
+[[nodiscard]] P3A_HOST_DEVICE inline auto
+exp_tangent(matrix3x3<T> const& A)
+{
+  matrix3x3<T> E[9];
+  for (int k = 0; k < 9; ++k) {
+    E[k]               = matrix3x3<T>::zero();
+    E[k](k / 3, k % 3) = T(1);
+  }
+  matrix3x3<T> X;
+  matrix3x3<T> L[9];
+  details::exp_frechet_directions(A, E, X, L);
+  static_matrix<T, 9, 9> J;
+  for (int i = 0; i < 9; ++i) {
+    for (int k = 0; k < 9; ++k) J(i, k) = L[k](i / 3, i % 3);
+  }
+  return J;
+}
+
+// Derivative of the exponential map at a symmetric tensor with respect to
+// symmetric perturbations, in Mandel form
+template <typename T>
+[[nodiscard]] P3A_HOST_DEVICE inline auto
+exp_tangent(symmetric3x3<T> const& A)
+{
+  return mandel6x6<T>(details::exp_tangent_mandel_matrix(matrix3x3<T>(A)), false);
+}
+
 // Exponential map by power series for verification, radius of convergence is infinity
 template <typename T>
 [[nodiscard]] P3A_HOST_DEVICE inline auto
@@ -3,6 +3,8 @@
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <type_traits>
+#include <utility>
 
 #include "p3a_macros.hpp"
 #include "p3a_constants.hpp"
@@ -39,22 +41,101 @@ condition(bool a, T const& b, T const& c)
   return a ? b : c;
 }
 
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+bool all_of(bool a)
+{
+  return a;
+}
+
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+bool any_of(bool a)
+{
+  return a;
+}
+
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+bool none_of(bool a)
+{
+  return !a;
+}
+
 using Kokkos::min;
 using Kokkos::max;
 using Kokkos::clamp;
 using Kokkos::abs;
 using Kokkos::sqrt;
-using Kokkos::cbrt;
-using Kokkos::sin;
-using Kokkos::cos;
 using Kokkos::tan;
 using Kokkos::asin;
 using Kokkos::acos;
-using Kokkos::exp;
-using Kokkos::pow;
-using Kokkos::log;
 using Kokkos::hypot;
 
+namespace details {
+
+// the argument types Kokkos has math functions for: arithmetic types here,
+// and Kokkos SIMD types once p3a_simd.hpp specializes this
+template <class T>
+struct is_math_argument {
+  inline static constexpr bool value = std::is_arithmetic_v<T>;
+};
+
+template <class T>
+inline constexpr bool is_math_argument_v = is_math_argument<T>::value;
+
+}
+
+// these forward to Kokkos so that p3a_simd_math.hpp can provide
+// more specialized vectorized overloads for simd<double>.
+// they are constrained so that they do not capture the overloads
+// other headers provide for tensors and other types.
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+std::enable_if_t<details::is_math_argument_v<T>,
+  decltype(Kokkos::cbrt(std::declval<T const&>()))>
+cbrt(T const& a) { return Kokkos::cbrt(a); }
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+std::enable_if_t<details::is_math_argument_v<T>,
+  decltype(Kokkos::sin(std::declval<T const&>()))>
+sin(T const& a) { return Kokkos::sin(a); }
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+std::enable_if_t<details::is_math_argument_v<T>,
+  decltype(Kokkos::cos(std::declval<T const&>()))>
+cos(T const& a) { return Kokkos::cos(a); }
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+std::enable_if_t<details::is_math_argument_v<T>,
+  decltype(Kokkos::exp(std::declval<T const&>()))>
+exp(T const& a) { return Kokkos::exp(a); }
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+std::enable_if_t<details::is_math_argument_v<T>,
+  decltype(Kokkos::log(std::declval<T const&>()))>
+log(T const& a) { return Kokkos::log(a); }
+
+template <class A, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+std::enable_if_t<details::is_math_argument_v<A> && details::is_math_argument_v<B>,
+  decltype(Kokkos::pow(std::declval<A const&>(), std::declval<B const&>()))>
+pow(A const& a, B const& b) { return Kokkos::pow(a, b); }
+
+template <class A, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+std::enable_if_t<details::is_math_argument_v<A> && details::is_math_argument_v<B>,
+  decltype(Kokkos::atan2(std::declval<A const&>(), std::declval<B const&>()))>
+atan2(A const& a, B const& b) { return Kokkos::atan2(a, b); }
+
+template <class Head>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+Head const& recursive_maximum(Head const& head)
+{
+  return head;
+}
+
 template <class Head, class... Tail>
 [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr auto
 recursive_maximum(Head const& head, Tail... tail)
@@ -70,13 +151,6 @@ maximum(T const& a, T const& b, T const& c, Tail... tail)
   return recursive_maximum(a, b, c, std::forward<Tail>(tail)...);
 }
 
-template <class Head>
-[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
-Head const& recursive_maximum(Head const& head)
-{
-  return head;
-}
-
 template <class T>
 [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
 T ceildiv(T a, T b) {
@@ -130,6 +204,16 @@ void swap(T& t1, T& t2) {
     t2 = std::move(temp);
 }
 
+// swaps a and b where mask is true; mask may be a SIMD mask
+template <class Mask, class T>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void conditional_swap(Mask const& mask, T& a, T& b)
+{
+  T const old_a = a;
+  a = condition(mask, b, a);
+  b = condition(mask, old_a, b);
+}
+
 // In the algrebra of rotations one often comes across functions that
 // take undefined (0/0) values at some points. Close to such points
 // these functions must be evaluated using their asymptotic
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "mpicpp.hpp"
+
+#include "p3a_grid3.hpp"
+#include "p3a_dynamic_array.hpp"
+#include "p3a_for_each.hpp"
+
+namespace p3a {
+
+/* Ghost-cell exchange for a grid3 decomposed into one subgrid3 per rank.
+
+   Each rank stores its field over its owned subgrid grown by the ghost
+   width on every side (ghosted()), indexed in "layout left" order by
+   ghosted().index(point) with points in global coordinates. exchange()
+   fills every ghost cell that is owned by some rank, or by a periodic image
+   of some rank, with that owner's value. Ghost cells beyond a non-periodic
+   boundary of the global grid are left alone for boundary conditions.
+
+   The owned subgrids of all ranks are gathered once at construction, and
+   each intersection between this rank's ghost layer and another rank's
+   owned cells becomes one message with a fixed place in persistent send
+   and receive buffers. Corners and edges fall out of the same
+   intersections, so one round of messages suffices. start() packs the
+   outgoing regions and posts non-blocking sends and receives; finish()
+   waits for them and unpacks, so work on the interior of the owned subgrid
+   can run in between. MPI counts are int, so a message of more than 2 GiB
+   goes out as several pieces with the same tag, which MPI delivers in the
+   order they were sent. */
+
+namespace details {
+
+struct halo_message {
+  int rank;
+  int tag;
+  subgrid3 region;
+  std::int64_t offset;
+};
+
+[[nodiscard]] inline
+subgrid3 grow(subgrid3 const& s, int width)
+{
+  return subgrid3(
+      s.lower() - vector3<int>(width, width, width),
+      s.upper() + vector3<int>(width, width, width));
+}
+
+[[nodiscard]] inline
+subgrid3 shift(subgrid3 const& s, vector3<int> const& offset)
+{
+  return subgrid3(s.lower() + offset, s.upper() + offset);
+}
+
+template <class T>
+class halo_pack_functor {
+  subgrid3 ghosted;
+  subgrid3 region;
+  T const* field;
+  T* buffer;
+ public:
+  halo_pack_functor(
+      subgrid3 ghosted_arg,
+      subgrid3 region_arg,
+      T const* field_arg,
+      T* buffer_arg)
+    :ghosted(ghosted_arg)
+    ,region(region_arg)
+    ,field(field_arg)
+    ,buffer(buffer_arg)
+  {}
+  P3A_ALWAYS_INLINE P3A_HOST_DEVICE void operator()(vector3<int> const& point) const {
+    buffer[region.index(point)] = field[ghosted.index(point)];
+  }
+};
+
+template <class T>
+class halo_unpack_functor {
+  subgrid3 ghosted;
+  subgrid3 region;
+  T const* buffer;
+  T* field;
+ public:
+  halo_unpack_functor(
+      subgrid3 ghosted_arg,
+      subgrid3 region_arg,
+      T const* buffer_arg,
+      T* field_arg)
+    :ghosted(ghosted_arg)
+    ,region(region_arg)
+    ,buffer(buffer_arg)
+    ,field(field_arg)
+  {}
+  P3A_ALWAYS_INLINE P3A_HOST_DEVICE void operator()(vector3<int> const& point) const {
+    field[ghosted.index(point)] = buffer[region.index(point)];
+  }
+};
+
+}
+
+template <
+  class T,
+  class Allocator = host_allocator<T>,
+  class ExecutionPolicy = execution::sequenced_policy>
+class halo_exchange {
+ public:
+  using buffer_type = dynamic_array<T, Allocator, ExecutionPolicy>;
+ private:
+  mpicpp::comm m_comm;
+  subgrid3 m_owned;
+  subgrid3 m_ghosted;
+  std::vector<details::halo_message> m_sends;
+  std::vector<details::halo_message> m_receives;
+  buffer_type m_send_buffer;
+  buffer_type m_receive_buffer;
+  std::vector<mpicpp::request> m_requests;
+  T* m_field = nullptr;
+  bool m_in_flight = false;
+  // the most values of T one MPI message can carry
+  static constexpr std::int64_t max_piece =
+    std::int64_t(std::numeric_limits<int>::max()) / std::int64_t(sizeof(T));
+  [[nodiscard]] static int piece_bytes(std::int64_t count)
+  {
+    return int(count * std::int64_t(sizeof(T)));
+  }
+ public:
+  halo_exchange() = default;
+  halo_exchange(
+      mpicpp::comm&& comm_arg,
+      grid3 const& global_grid,
+      subgrid3 const& owned_arg,
+      int ghost_width,
+      vector3<bool> const& periodic = vector3<bool>(false, false, false))
+    :m_comm(std::move(comm_arg))
+    ,m_owned(owned_arg)
+    ,m_ghosted(details::grow(owned_arg, ghost_width))
+  {
+    for (int axis = 0; axis < 3; ++axis) {
+      if (periodic[axis] && ghost_width > global_grid.extents()[axis]) {
+        throw std::invalid_argument(
+            "p3a::halo_exchange ghost width exceeds a periodic extent of the grid");
+      }
+    }
+    int const rank = m_comm.rank();
+    int const size = m_comm.size();
+    std::vector<int> bounds(std::size_t(6 * size), 0);
+    for (int axis = 0; axis < 3; ++axis) {
+      bounds[std::size_t(6 * rank + axis)] = m_owned.lower()[axis];
+      bounds[std::size_t(6 * rank + 3 + axis)] = m_owned.upper()[axis];
+    }
+    auto gather = m_comm.iallreduce(bounds.data(), 6 * size, mpicpp::op::sum());
+    gather.wait();
+    std::int64_t send_size = 0;
+    std::int64_t receive_size = 0;
+    for (int k = -1; k <= 1; ++k) {
+      for (int j = -1; j <= 1; ++j) {
+        for (int i = -1; i <= 1; ++i) {
+          auto const image = vector3<int>(i, j, k);
+          bool is_image = true;
+          for (int axis = 0; axis < 3; ++axis) {
+            if (image[axis] != 0 && !periodic[axis]) is_image = false;
+          }
+          if (!is_image) continue;
+          // the periodic image at this offset and its exchanges share a tag
+          auto const offset = vector3<int>(
+              i * global_grid.extents().x(),
+              j * global_grid.extents().y(),
+              k * global_grid.extents().z());
+          int const tag = (k + 1) * 9 + (j + 1) * 3 + (i + 1);
+          for (int other = 0; other < size; ++other) {
+            if (other == rank && image == vector3<int>::zero()) continue;
+            auto const other_owned = subgrid3(
+                vector3<int>(
+                  bounds[std::size_t(6 * other + 0)],
+                  bounds[std::size_t(6 * other + 1)],
+                  bounds[std::size_t(6 * other + 2)]),
+                vector3<int>(
+                  bounds[std::size_t(6 * other + 3)],
+                  bounds[std::size_t(6 * other + 4)],
+                  bounds[std::size_t(6 * other + 5)]));
+            auto const receive_region = intersect(m_ghosted, details::shift(other_owned, offset));
+            if (receive_region.size() > 0) {
+              m_receives.push_back(details::halo_message{other, tag, receive_region, receive_size});
+              receive_size += receive_region.size();
+            }
+            auto const send_region = intersect(m_owned,
+                details::shift(details::grow(other_owned, ghost_width), -offset));
+            if (send_region.size() > 0) {
+              m_sends.push_back(details::halo_message{other, tag, send_region, send_size});
+              send_size += send_region.size();
+            }
+          }
+        }
+      }
+    }
+    m_send_buffer.resize(send_size);
+    m_receive_buffer.resize(receive_size);
+    m_requests.reserve(m_sends.size() + m_receives.size());
+  }
+  halo_exchange(halo_exchange&&) = default;
+  halo_exchange& operator=(halo_exchange&&) = default;
+  halo_exchange(halo_exchange const&) = delete;
+  halo_exchange& operator=(halo_exchange const&) = delete;
+  [[nodiscard]] P3A_ALWAYS_INLINE inline constexpr
+  subgrid3 const& owned() const { return m_owned; }
+  [[nodiscard]] P3A_ALWAYS_INLINE inline constexpr
+  subgrid3 const& ghosted() const { return m_ghosted; }
+  // packs owned values of field needed elsewhere and posts all messages
+  void start(T* field)
+  {
+    if (m_in_flight) {
+      throw std::logic_error("p3a::halo_exchange::start called twice without finish");
+    }
+    m_field = field;
+    auto const policy = m_send_buffer.get_execution_policy();
+    T* const receive_buffer = m_receive_buffer.data();
+    T* const send_buffer = m_send_buffer.data();
+    for (auto const& message : m_receives) {
+      for (std::int64_t first = 0; first < message.region.size(); first += max_piece) {
+        m_requests.push_back(m_comm.irecv(
+              receive_buffer + message.offset + first,
+              piece_bytes(std::min(max_piece, message.region.size() - first)),
+              mpicpp::datatype::predefined_packed(),
+              message.rank,
+              message.tag));
+      }
+    }
+    for (auto const& message : m_sends) {
+      for_each(policy, message.region,
+          details::halo_pack_functor<T>(m_ghosted, message.region, field, send_buffer + message.offset));
+    }
+    policy.synchronize();
+    for (auto const& message : m_sends) {
+      for (std::int64_t first = 0; first < message.region.size(); first += max_piece) {
+        m_requests.push_back(m_comm.isend(
+              send_buffer + message.offset + first,
+              piece_bytes(std::min(max_piece, message.region.size() - first)),
+              mpicpp::datatype::predefined_packed(),
+              message.rank,
+              message.tag));
+      }
+    }
+    m_in_flight = true;
+  }
+  // waits for all messages and writes the received values into the ghost cells
+  void finish()
+  {
+    if (!m_in_flight) {
+      throw std::logic_error("p3a::halo_exchange::finish called without start");
+    }
+    for (auto& request : m_requests) request.wait();
+    m_requests.clear();
+    auto const policy = m_receive_buffer.get_execution_policy();
+    T const* const receive_buffer = m_receive_buffer.data();
+    for (auto const& message : m_receives) {
+      for_each(policy, message.region,
+          details::halo_unpack_functor<T>(m_ghosted, message.region, receive_buffer + message.offset, m_field));
+    }
+    policy.synchronize();
+    m_field = nullptr;
+    m_in_flight = false;
+  }
+  void exchange(T* field)
+  {
+    start(field);
+    finish();
+  }
+};
+
+template <class T>
+using device_halo_exchange =
+  halo_exchange<T, device_allocator<T>, execution::parallel_policy>;
+
+}
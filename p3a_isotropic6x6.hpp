@@ -0,0 +1,632 @@
+#pragma once
+
+#include "p3a_macros.hpp"
+#include "p3a_constants.hpp"
+#include "p3a_vector3.hpp"
+#include "p3a_symmetric3x3.hpp"
+#include "p3a_static_matrix.hpp"
+#include "p3a_mandel6x1.hpp"
+#include "p3a_mandel6x6.hpp"
+
+/********************************* NOTES ************************************
+ * This header provides the classes:
+ *
+ * - `isotropic6x6` isotropic 4th order Tensor
+ * - `transversely_isotropic6x6` transversely isotropic 4th order Tensor
+ *
+ * Both store only the parameters of the tensor, and every operation below
+ * works on those parameters directly instead of on 36 Mandel components.
+ *
+ * An isotropic tensor is `a P_vol + b P_dev`, where `P_vol = (1/3) 1 (x) 1`
+ * and `P_dev = I - P_vol` are the volumetric and deviatoric projectors,
+ * so an elastic stiffness has `a = 3 K` and `b = 2 G`. Composition,
+ * `tensor_inverse` and products with `mandel6x1` cost a handful of flops:
+ * `C * e` is just `2 G e + lambda tr(e) 1`.
+ *
+ * `tensor_inverse(C)` is the inverse under composition, so that
+ * `tensor_inverse(C) * C` is the identity. `inverse(C)` instead follows the
+ * convention of `inverse(mandel6x6)`, which inverts the Voigt form, so that
+ * `inverse(C) == inverse(C.full())`. That result has its shear block scaled
+ * by four and is no longer of either form here, so it is a `mandel6x6`.
+ *
+ * A transversely isotropic tensor about the unit axis `n` is written in the
+ * Walpole basis built from `P = n (x) n` and `Q = I - P`:
+ *
+ *   E1 = (1/2) Q (x) Q       E2 = P (x) P
+ *   E3 = (1/sqrt 2) Q (x) P  E4 = (1/sqrt 2) P (x) Q
+ *   E5 = Q (.) Q - E1        E6 = P (.) Q + Q (.) P
+ *
+ * as `c1 E1 + c2 E2 + c3 E3 + c4 E4 + c5 E5 + c6 E6`. The (E1..E4) part
+ * multiplies like the 2x2 matrix [c1 c3; c4 c2] while E5 and E6 are
+ * orthogonal projectors, so composition and tensor_inverse reduce to 2x2
+ * algebra.
+ * Stiffnesses have c3 == c4 and therefore 5 independent constants; the
+ * sixth is kept so that products of two such tensors are representable.
+ * Composition and sums require both operands to share the same axis.
+ *
+ * Use `full()` to convert to a `mandel6x6` for anything not listed here.
+ *
+ * See additional notes in `p3a_mandel6x1.hpp`.
+ */
+
+namespace p3a {
+
+/******************************************************************/
+/******************************************************************/
+template <class T>
+class isotropic6x6
+/**
+ * Represents an isotropic 4th order tensor by its eigenvalues on the
+ * volumetric and deviatoric subspaces
+ */
+/******************************************************************/
+{
+ T m_volumetric;
+ T m_deviatoric;
+
+ public:
+
+  /**** constructors, destructors, and assigns ****/
+  P3A_ALWAYS_INLINE constexpr
+  isotropic6x6() = default;
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  isotropic6x6(T const& volumetric_arg, T const& deviatoric_arg)
+    :m_volumetric(volumetric_arg)
+    ,m_deviatoric(deviatoric_arg)
+  {}
+
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  isotropic6x6<T> from_bulk_and_shear(T const& bulk, T const& shear)
+  {
+    return isotropic6x6<T>(T(3) * bulk, T(2) * shear);
+  }
+
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  isotropic6x6<T> from_lame(T const& lambda, T const& mu)
+  {
+    return isotropic6x6<T>(T(3) * lambda + T(2) * mu, T(2) * mu);
+  }
+
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  isotropic6x6<T> zero()
+  {
+    return isotropic6x6<T>(T(0), T(0));
+  }
+
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  isotropic6x6<T> identity()
+  {
+    return isotropic6x6<T>(T(1), T(1));
+  }
+
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& volumetric() const { return m_volumetric; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& deviatoric() const { return m_deviatoric; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& volumetric() { return m_volumetric; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& deviatoric() { return m_deviatoric; }
+
+  //elastic moduli when this tensor is a stiffness
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T bulk() const { return m_volumetric / T(3); }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T shear() const { return m_deviatoric / T(2); }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T lame() const { return (m_volumetric - m_deviatoric) / T(3); }
+
+  //the equivalent full Mandel tensor
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  mandel6x6<T> full() const
+  {
+    T const d = (m_volumetric + T(2) * m_deviatoric) / T(3);
+    T const o = (m_volumetric - m_deviatoric) / T(3);
+    T const s = m_deviatoric;
+    return mandel6x6<T>(
+        d,    o,    o,    T(0), T(0), T(0),
+        o,    d,    o,    T(0), T(0), T(0),
+        o,    o,    d,    T(0), T(0), T(0),
+        T(0), T(0), T(0), s,    T(0), T(0),
+        T(0), T(0), T(0), T(0), s,    T(0),
+        T(0), T(0), T(0), T(0), T(0), s,
+        false);
+  }
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  isotropic6x6<T>& operator+=(isotropic6x6<T> const& b)
+  {
+    m_volumetric += b.volumetric();
+    m_deviatoric += b.deviatoric();
+    return *this;
+  }
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  isotropic6x6<T>& operator-=(isotropic6x6<T> const& b)
+  {
+    m_volumetric -= b.volumetric();
+    m_deviatoric -= b.deviatoric();
+    return *this;
+  }
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  isotropic6x6<T>& operator*=(T const& c)
+  {
+    m_volumetric *= c;
+    m_deviatoric *= c;
+    return *this;
+  }
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  isotropic6x6<T>& operator/=(T const& c)
+  {
+    m_volumetric /= c;
+    m_deviatoric /= c;
+    return *this;
+  }
+};
+
+/*****************************************************************************
+ * Operators overloads for isotropic6x6 tensors
+ *****************************************************************************/
+
+template <class A, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator+(isotropic6x6<A> const& a, isotropic6x6<B> const& b)
+{
+  using result_type = decltype(a.volumetric() + b.volumetric());
+  return isotropic6x6<result_type>(
+      a.volumetric() + b.volumetric(),
+      a.deviatoric() + b.deviatoric());
+}
+
+template <class A, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator-(isotropic6x6<A> const& a, isotropic6x6<B> const& b)
+{
+  using result_type = decltype(a.volumetric() - b.volumetric());
+  return isotropic6x6<result_type>(
+      a.volumetric() - b.volumetric(),
+      a.deviatoric() - b.deviatoric());
+}
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+isotropic6x6<T> operator-(isotropic6x6<T> const& a)
+{
+  return isotropic6x6<T>(-a.volumetric(), -a.deviatoric());
+}
+
+template <class A, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+typename std::enable_if<is_scalar<B>, isotropic6x6<decltype(A() * B())>>::type
+operator*(isotropic6x6<A> const& a, B const& c)
+{
+  return isotropic6x6<decltype(A() * B())>(
+      a.volumetric() * c, a.deviatoric() * c);
+}
+
+template <class A, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+typename std::enable_if<is_scalar<A>, isotropic6x6<decltype(A() * B())>>::type
+operator*(A const& c, isotropic6x6<B> const& a)
+{
+  return a * c;
+}
+
+template <class A, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+typename std::enable_if<is_scalar<B>, isotropic6x6<decltype(A() / B())>>::type
+operator/(isotropic6x6<A> const& a, B const& c)
+{
+  return isotropic6x6<decltype(A() / B())>(
+      a.volumetric() / c, a.deviatoric() / c);
+}
+
+//composition: the projectors are orthogonal, so eigenvalues multiply
+template <class A, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator*(isotropic6x6<A> const& a, isotropic6x6<B> const& b)
+{
+  using result_type = decltype(a.volumetric() * b.volumetric());
+  return isotropic6x6<result_type>(
+      a.volumetric() * b.volumetric(),
+      a.deviatoric() * b.deviatoric());
+}
+
+//inverse under composition
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+isotropic6x6<T> tensor_inverse(isotropic6x6<T> const& a)
+{
+  return isotropic6x6<T>(T(1) / a.volumetric(), T(1) / a.deviatoric());
+}
+
+//inverse(a.full()) in closed form
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+mandel6x6<T> inverse(isotropic6x6<T> const& a)
+{
+  return inverse_isotropic(a.bulk(), a.shear());
+}
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+isotropic6x6<T> transpose(isotropic6x6<T> const& a)
+{
+  return a;
+}
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+T trace(isotropic6x6<T> const& a)
+{
+  return a.volumetric() + T(5) * a.deviatoric();
+}
+
+/** Tensor multiply isotropic6x6 by mandel6x1 (6x1) **/
+template <class T, class U>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator*(
+    isotropic6x6<T> const &C,
+    mandel6x1<U> const &v)
+{
+  using result_type = decltype(C.volumetric() * v.x1());
+  auto const b = C.deviatoric();
+  auto const p = (C.volumetric() - b) * (v.x1() + v.x2() + v.x3()) / T(3);
+  return mandel6x1<result_type>(
+      b * v.x1() + p,
+      b * v.x2() + p,
+      b * v.x3() + p,
+      b * v.x4(),
+      b * v.x5(),
+      b * v.x6(),
+      false); //already transformed
+}
+
+/** Tensor multiply isotropic6x6 by symmetric3x3 (3x3) **/
+template <class T, class U>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator*(
+    isotropic6x6<T> const &C,
+    symmetric3x3<U> const &s)
+{
+  mandel6x1<U> v(s);
+  return C*v;
+}
+
+/** mixed products with mandel6x6 **/
+template <class T, class U>
+[[nodiscard]] P3A_HOST_DEVICE inline
+auto operator*(
+    isotropic6x6<T> const &C,
+    mandel6x6<U> const &D)
+{
+  return C.full() * D;
+}
+
+template <class T, class U>
+[[nodiscard]] P3A_HOST_DEVICE inline
+auto operator*(
+    mandel6x6<T> const &C,
+    isotropic6x6<U> const &D)
+{
+  return C * D.full();
+}
+
+/******************************************************************/
+/******************************************************************/
+template <class T>
+class transversely_isotropic6x6
+/**
+ * Represents a transversely isotropic 4th order tensor by its axis of
+ * symmetry and its coefficients in the Walpole basis
+ */
+/******************************************************************/
+{
+ vector3<T> m_axis;
+ T m_c1,m_c2,m_c3,m_c4,m_c5,m_c6;
+
+ public:
+
+  /**** constructors, destructors, and assigns ****/
+  P3A_ALWAYS_INLINE constexpr
+  transversely_isotropic6x6() = default;
+
+  //axis must have unit length
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  transversely_isotropic6x6(
+      vector3<T> const& axis_arg,
+      T const& C1, T const& C2, T const& C3,
+      T const& C4, T const& C5, T const& C6)
+    :m_axis(axis_arg)
+    ,m_c1(C1)
+    ,m_c2(C2)
+    ,m_c3(C3)
+    ,m_c4(C4)
+    ,m_c5(C5)
+    ,m_c6(C6)
+  {}
+
+  //the isotropic tensor a, viewed as transversely isotropic about axis
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE
+  transversely_isotropic6x6(
+      vector3<T> const& axis_arg,
+      isotropic6x6<T> const& a)
+    :m_axis(axis_arg)
+  {
+    T const b = a.deviatoric();
+    T const o = (a.volumetric() - b) / T(3);
+    T const r2 = square_root_of_two_value<T>();
+    m_c1 = b + T(2) * o;
+    m_c2 = b + o;
+    m_c3 = r2 * o;
+    m_c4 = r2 * o;
+    m_c5 = b;
+    m_c6 = b;
+  }
+
+  //stiffness given by the Voigt moduli in a frame whose third axis is axis,
+  //with c66 = (c11 - c12) / 2
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static
+  transversely_isotropic6x6<T> from_voigt(
+      vector3<T> const& axis_arg,
+      T const& c11, T const& c12, T const& c13,
+      T const& c33, T const& c44)
+  {
+    T const c = square_root_of_two_value<T>() * c13;
+    return transversely_isotropic6x6<T>(axis_arg,
+        c11 + c12, c33, c, c, c11 - c12, T(2) * c44);
+  }
+
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  transversely_isotropic6x6<T> identity(vector3<T> const& axis_arg)
+  {
+    return transversely_isotropic6x6<T>(axis_arg,
+        T(1), T(1), T(0), T(0), T(1), T(1));
+  }
+
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  vector3<T> const& axis() const { return m_axis; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& c1() const { return m_c1; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& c2() const { return m_c2; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& c3() const { return m_c3; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& c4() const { return m_c4; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& c5() const { return m_c5; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& c6() const { return m_c6; }
+
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  vector3<T>& axis() { return m_axis; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& c1() { return m_c1; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& c2() { return m_c2; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& c3() { return m_c3; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& c4() { return m_c4; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& c5() { return m_c5; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& c6() { return m_c6; }
+
+  //the double contraction with a symmetric tensor, computed from e n and
+  //n . e n without forming P or Q
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE
+  symmetric3x3<T> contract(symmetric3x3<T> const& e) const
+  {
+    T const r2i = T(1) / square_root_of_two_value<T>();
+    vector3<T> const& n = m_axis;
+    vector3<T> const w = e * n;
+    T const a = dot_product(n, w);
+    T const q = trace(e) - a;
+    T const k = m_c6 - m_c5;
+    T const alpha = T(0.5) * (m_c1 - m_c5) * q + r2i * m_c3 * a;
+    T const beta = (m_c2 + m_c5 - T(2) * m_c6) * a + r2i * m_c4 * q - alpha;
+    return symmetric3x3<T>(
+        m_c5 * e.xx() + T(2) * k * n.x() * w.x() + alpha + beta * n.x() * n.x(),
+        m_c5 * e.xy() + k * (n.x() * w.y() + w.x() * n.y()) + beta * n.x() * n.y(),
+        m_c5 * e.xz() + k * (n.x() * w.z() + w.x() * n.z()) + beta * n.x() * n.z(),
+        m_c5 * e.yy() + T(2) * k * n.y() * w.y() + alpha + beta * n.y() * n.y(),
+        m_c5 * e.yz() + k * (n.y() * w.z() + w.y() * n.z()) + beta * n.y() * n.z(),
+        m_c5 * e.zz() + T(2) * k * n.z() * w.z() + alpha + beta * n.z() * n.z());
+  }
+
+  //the equivalent full Mandel tensor, one column per Mandel basis tensor
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE
+  mandel6x6<T> full() const
+  {
+    static_matrix<T,6,6> m;
+    for (int j = 0; j < 6; ++j) {
+      mandel6x1<T> e(T(0), T(0), T(0), T(0), T(0), T(0), false);
+      if (j == 0) e.x1() = T(1);
+      if (j == 1) e.x2() = T(1);
+      if (j == 2) e.x3() = T(1);
+      if (j == 3) e.x4() = T(1);
+      if (j == 4) e.x5() = T(1);
+      if (j == 5) e.x6() = T(1);
+      mandel6x1<T> const c(contract(mandel6x1_to_symmetric3x3(e)));
+      m(0,j) = c.x1();
+      m(1,j) = c.x2();
+      m(2,j) = c.x3();
+      m(3,j) = c.x4();
+      m(4,j) = c.x5();
+      m(5,j) = c.x6();
+    }
+    return mandel6x6<T>(m, false);
+  }
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  transversely_isotropic6x6<T>& operator*=(T const& c)
+  {
+    m_c1 *= c;
+    m_c2 *= c;
+    m_c3 *= c;
+    m_c4 *= c;
+    m_c5 *= c;
+    m_c6 *= c;
+    return *this;
+  }
+};
+
+/*****************************************************************************
+ * Operators overloads for transversely_isotropic6x6 tensors
+ *****************************************************************************/
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+transversely_isotropic6x6<T> operator+(
+    transversely_isotropic6x6<T> const& a,
+    transversely_isotropic6x6<T> const& b)
+{
+  return transversely_isotropic6x6<T>(a.axis(),
+      a.c1() + b.c1(), a.c2() + b.c2(), a.c3() + b.c3(),
+      a.c4() + b.c4(), a.c5() + b.c5(), a.c6() + b.c6());
+}
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+transversely_isotropic6x6<T> operator-(
+    transversely_isotropic6x6<T> const& a,
+    transversely_isotropic6x6<T> const& b)
+{
+  return transversely_isotropic6x6<T>(a.axis(),
+      a.c1() - b.c1(), a.c2() - b.c2(), a.c3() - b.c3(),
+      a.c4() - b.c4(), a.c5() - b.c5(), a.c6() - b.c6());
+}
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+transversely_isotropic6x6<T> operator-(
+    transversely_isotropic6x6<T> const& a)
+{
+  return transversely_isotropic6x6<T>(a.axis(),
+      -a.c1(), -a.c2(), -a.c3(), -a.c4(), -a.c5(), -a.c6());
+}
+
+template <class T, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+typename std::enable_if<is_scalar<B>, transversely_isotropic6x6<T>>::type
+operator*(transversely_isotropic6x6<T> const& a, B const& c)
+{
+  return transversely_isotropic6x6<T>(a.axis(),
+      a.c1() * c, a.c2() * c, a.c3() * c,
+      a.c4() * c, a.c5() * c, a.c6() * c);
+}
+
+template <class A, class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+typename std::enable_if<is_scalar<A>, transversely_isotropic6x6<T>>::type
+operator*(A const& c, transversely_isotropic6x6<T> const& a)
+{
+  return a * c;
+}
+
+template <class T, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+typename std::enable_if<is_scalar<B>, transversely_isotropic6x6<T>>::type
+operator/(transversely_isotropic6x6<T> const& a, B const& c)
+{
+  return transversely_isotropic6x6<T>(a.axis(),
+      a.c1() / c, a.c2() / c, a.c3() / c,
+      a.c4() / c, a.c5() / c, a.c6() / c);
+}
+
+//composition of two tensors about the same axis
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+transversely_isotropic6x6<T> operator*(
+    transversely_isotropic6x6<T> const& a,
+    transversely_isotropic6x6<T> const& b)
+{
+  return transversely_isotropic6x6<T>(a.axis(),
+      a.c1() * b.c1() + a.c3() * b.c4(),
+      a.c4() * b.c3() + a.c2() * b.c2(),
+      a.c1() * b.c3() + a.c3() * b.c2(),
+      a.c4() * b.c1() + a.c2() * b.c4(),
+      a.c5() * b.c5(),
+      a.c6() * b.c6());
+}
+
+//inverse under composition
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+transversely_isotropic6x6<T> tensor_inverse(
+    transversely_isotropic6x6<T> const& a)
+{
+  T const d = T(1) / (a.c1() * a.c2() - a.c3() * a.c4());
+  return transversely_isotropic6x6<T>(a.axis(),
+      a.c2() * d, a.c1() * d, -a.c3() * d, -a.c4() * d,
+      T(1) / a.c5(), T(1) / a.c6());
+}
+
+//inverse(a.full()) without elimination: inverse(mandel6x6) gives
+//D^2 C^-1 D^2 with D = diag(1, 1, 1, sqrt 2, sqrt 2, sqrt 2),
+//and each Mandel transform applies one D on both sides
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE inline
+mandel6x6<T> inverse(
+    transversely_isotropic6x6<T> const& a)
+{
+  auto result = tensor_inverse(a).full();
+  result.MandelXform();
+  result.MandelXform();
+  return result;
+}
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+transversely_isotropic6x6<T> transpose(
+    transversely_isotropic6x6<T> const& a)
+{
+  return transversely_isotropic6x6<T>(a.axis(),
+      a.c1(), a.c2(), a.c4(), a.c3(), a.c5(), a.c6());
+}
+
+/** Tensor multiply transversely_isotropic6x6 by symmetric3x3 (3x3) **/
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE inline
+mandel6x1<T> operator*(
+    transversely_isotropic6x6<T> const &C,
+    symmetric3x3<T> const &s)
+{
+  return mandel6x1<T>(C.contract(s));
+}
+
+/** Tensor multiply transversely_isotropic6x6 by mandel6x1 (6x1) **/
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE inline
+mandel6x1<T> operator*(
+    transversely_isotropic6x6<T> const &C,
+    mandel6x1<T> const &v)
+{
+  return C * mandel6x1_to_symmetric3x3(v);
+}
+
+/** mixed products with mandel6x6 **/
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE inline
+mandel6x6<T> operator*(
+    transversely_isotropic6x6<T> const &C,
+    mandel6x6<T> const &D)
+{
+  return C.full() * D;
+}
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE inline
+mandel6x6<T> operator*(
+    mandel6x6<T> const &C,
+    transversely_isotropic6x6<T> const &D)
+{
+  return C * D.full();
+}
+
+}
@@ -2,8 +2,12 @@
 
 // The logarithmic map computed by Padé approximants.
 
+#include <type_traits>
+
 #include "p3a_matrix3x3.hpp"
 #include "p3a_tensor_detail.hpp"
+#include "p3a_exp.hpp"
+#include "p3a_static_matrix_solve.hpp"
 
 namespace p3a {
 
@@ -41,6 +45,45 @@ sqrt_dbp(matrix3x3<T> const& A, int& k)
   return X;
 }
 
+// Denman-Beavers product form iterated independently in each SIMD lane:
+// lanes that have converged are frozen so they match sqrt_dbp exactly.
+template <typename T>
+[[nodiscard]] P3A_HOST_DEVICE inline auto
+masked_sqrt_dbp(matrix3x3<T> const& A)
+{
+  using scalar_type   = scalar_type_t<T>;
+  using mask_type     = decltype(T() < T());
+  auto const eps      = epsilon_value<scalar_type>();
+  auto const tol      = T(0.5 * p3a::sqrt(3.0) * eps);  // 3 is dim
+  auto const I        = matrix3x3<T>::identity();
+  auto const max_iter = 32;
+  auto       X        = A;
+  auto       M        = A;
+  mask_type  scale(true);
+  mask_type  is_done(false);
+  for (int k = 0; k < max_iter; ++k) {
+    auto const is_scaling = scale && (!is_done);
+    if (any_of(is_scaling)) {
+      auto const d  = p3a::abs(determinant(M));
+      auto const d2 = p3a::sqrt(condition(is_scaling, d, T(1)));
+      auto const d6 = p3a::cbrt(d2);
+      auto const g  = T(1) / d6;
+      X *= g;
+      M *= g * g;
+    }
+    auto const Y = X;
+    auto const N = inverse(M);
+    X            = condition(is_done, X, X * (0.5 * (I + N)));
+    M            = condition(is_done, M, 0.5 * (I + 0.5 * (M + N)));
+    auto const error = norm(M - I);
+    auto const diff  = norm(X - Y) / norm(X);
+    scale            = (diff >= T(0.01));
+    is_done          = is_done || (error <= tol);
+    if (all_of(is_done)) break;
+  }
+  return X;
+}
+
 // Matrix square root
 template <typename T>
 [[nodiscard]] P3A_HOST_DEVICE inline auto
@@ -101,12 +144,97 @@ log_iss(matrix3x3<T> const& A)
   return X;
 }
 
+// Logarithmic map by inverse scaling and squaring for SIMD types.
+// Square roots are taken per lane until every lane is within the range of
+// the order 8 approximant, then a single Padé order, the lowest one that is
+// accurate for all lanes, is evaluated by partial fractions for the whole
+// vector, since its cost is one inverse per term regardless of the lane.
+template <typename T>
+[[nodiscard]] P3A_HOST_DEVICE inline auto
+masked_log_iss(matrix3x3<T> const& A)
+{
+  using scalar_type         = scalar_type_t<T>;
+  auto const     I          = matrix3x3<T>::identity();
+  int constexpr  max_order  = 8;
+  auto const     theta      = T(pade_coefficients<scalar_type>(max_order - 1));
+  auto           X          = A;
+  T              root_scale = T(1);
+  for (int k = 0; k < 64; ++k) {
+    auto const needs_root = (norm_1(X - I) > theta);
+    if (none_of(needs_root)) break;
+    X          = condition(needs_root, masked_sqrt_dbp(condition(needs_root, X, I)), X);
+    root_scale = condition(needs_root, T(2) * root_scale, root_scale);
+  }
+  auto const E    = X - I;
+  auto const diff = norm_1(E);
+  int        m    = 3;
+  while (m < max_order && !all_of(diff < T(pade_coefficients<scalar_type>(m - 1)))) {
+    ++m;
+  }
+  auto L = matrix3x3<T>::zero();
+  for (int i = 0; i < m; ++i) {
+    auto const x = 0.5 * (1.0 + gauss_legendre_abscissae<scalar_type>(m, i));
+    auto const w = 0.5 * gauss_legendre_weights<scalar_type>(m, i);
+    L += w * E * inverse(I + x * E);
+  }
+  return root_scale * L;
+}
+
 // Logarithmic map
 template <typename T>
 [[nodiscard]] P3A_HOST_DEVICE inline auto
 log(matrix3x3<T> const& A)
 {
-  return log_iss(A);
+  if constexpr (std::is_same_v<scalar_type_t<T>, T>) {
+    return log_iss(A);
+  } else {
+    return masked_log_iss(A);
+  }
+}
+
+// Derivative of the logarithmic map d log(A)_ij / d A_kl as a 9x9 matrix
+// with row 3i+j and column 3k+l. Since exp(log(A)) = A, it is the inverse of
+// the Padé-based exp_tangent() at log(A), which costs one 9x9 factorization
+// instead of the Sylvester solves needed to differentiate every square root
+// of the inverse scaling and squaring algorithm.
+// returns, per lane, whether exp_tangent() was singular, in which case
+// that lane of K is meaningless.
+template <typename T>
+[[nodiscard]] P3A_HOST_DEVICE inline auto
+log_tangent(matrix3x3<T> const& A, static_matrix<T, 9, 9>& K)
+{
+  auto J = exp_tangent(log(A));
+  K = static_matrix<T, 9, 9>::identity();
+  return lu_solve(J, K);
+}
+
+// Fréchet derivative L of the logarithmic map at A in the direction E.
+// returns the same singular mask as log_tangent().
+template <typename T>
+[[nodiscard]] P3A_HOST_DEVICE inline auto
+log_frechet(matrix3x3<T> const& A, matrix3x3<T> const& E, matrix3x3<T>& L)
+{
+  auto J = exp_tangent(log(A));
+  static_matrix<T, 9, 1> e;
+  for (int k = 0; k < 9; ++k) e(k, 0) = E(k / 3, k % 3);
+  auto const singular = lu_solve(J, e);
+  for (int k = 0; k < 9; ++k) L(k / 3, k % 3) = e(k, 0);
+  return singular;
+}
+
+// Derivative of the logarithmic map at a symmetric positive definite tensor
+// with respect to symmetric perturbations, in Mandel form.
+// returns the same singular mask as log_tangent() of a matrix3x3.
+template <typename T>
+[[nodiscard]] P3A_HOST_DEVICE inline auto
+log_tangent(symmetric3x3<T> const& A, mandel6x6<T>& D)
+{
+  auto const X        = matrix3x3<T>(symmetric_part(log(matrix3x3<T>(A))));
+  auto       J        = details::exp_tangent_mandel_matrix(X);
+  auto       K        = static_matrix<T, 6, 6>::identity();
+  auto const singular = lu_solve(J, K);
+  D                   = mandel6x6<T>(K, false);
+  return singular;
 }
 
 // Logarithm by Gregory series for verification. Convergence guaranteed for symmetric A
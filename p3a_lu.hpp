@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "p3a_dynamic_matrix.hpp"
+
+namespace p3a {
+
+/* LU factorization with partial pivoting, PA = LU, which is computed once
+   and then reused for any number of solves.
+   Factorization is blocked and right-looking: each panel of columns is
+   factored on the host, and the trailing submatrix update, which dominates
+   the cost, runs through the parallel GEMM of dynamic_matrix.
+   L (unit lower triangular) and U share one matrix, as in LAPACK's getrf. */
+
+template <
+  class T,
+  class Allocator = host_allocator<T>,
+  class ExecutionPolicy = execution::sequenced_policy>
+class lu_factorization {
+ public:
+  using matrix_type = dynamic_matrix<T, Allocator, ExecutionPolicy>;
+ private:
+  matrix_type m_factors;
+  std::vector<int> m_pivots;
+  int m_pivot_sign = 1;
+  bool m_is_singular = false;
+  T m_norm = T(0);
+  int m_block_size = 64;
+ public:
+  lu_factorization() = default;
+  explicit lu_factorization(matrix_type const& a)
+  {
+    factor(a);
+  }
+  void set_block_size(int block_size_arg)
+  {
+    if (block_size_arg < 1) {
+      throw std::invalid_argument("LU factorization: block size must be positive");
+    }
+    m_block_size = block_size_arg;
+  }
+  void factor(matrix_type const& a)
+  {
+    m_factors = a;
+    factor_in_place();
+  }
+  void factor(matrix_type&& a)
+  {
+    m_factors = std::move(a);
+    factor_in_place();
+  }
+  [[nodiscard]] int size() const { return m_factors.row_count(); }
+  [[nodiscard]] bool is_singular() const { return m_is_singular; }
+  [[nodiscard]] matrix_type const& factors() const { return m_factors; }
+  [[nodiscard]] std::vector<int> const& pivots() const { return m_pivots; }
+  // solves A X = B for every column of B at once
+  void solve(matrix_type const& b, matrix_type& x) const
+  {
+    x = b;
+    solve_in_place(x);
+  }
+  void solve_in_place(matrix_type& b) const
+  {
+    int const n = size();
+    if (b.row_count() != n) {
+      throw std::invalid_argument("LU solve: A rows != B rows");
+    }
+    if (m_is_singular) {
+      throw std::invalid_argument("LU solve: matrix is singular");
+    }
+    for (int k = 0; k < n; ++k) {
+      if (m_pivots[k] != k) swap_rows(b, k, m_pivots[k]);
+    }
+    int const column_count = b.column_count();
+    T const* const lu = m_factors.data();
+    T* const x = b.data();
+    for_each(b.get_execution_policy(),
+        counting_iterator<int>(0),
+        counting_iterator<int>(column_count),
+    [=] P3A_HOST_DEVICE (int j) P3A_ALWAYS_INLINE {
+      for (int i = 1; i < n; ++i) {
+        T sum = x[i * column_count + j];
+        for (int k = 0; k < i; ++k) {
+          sum -= lu[i * n + k] * x[k * column_count + j];
+        }
+        x[i * column_count + j] = sum;
+      }
+      for (int i = n - 1; i >= 0; --i) {
+        T sum = x[i * column_count + j];
+        for (int k = i + 1; k < n; ++k) {
+          sum -= lu[i * n + k] * x[k * column_count + j];
+        }
+        x[i * column_count + j] = sum / lu[i * n + i];
+      }
+    });
+  }
+  [[nodiscard]] T determinant() const
+  {
+    T result = T(m_pivot_sign);
+    for (int i = 0; i < size(); ++i) result *= m_factors(i, i);
+    return result;
+  }
+  // estimate of the 1-norm condition number ||A||_1 ||A^{-1}||_1 using
+  // Hager's method (Higham, ACM TOMS 14(4), 1988), which costs a few O(n^2) solves
+  [[nodiscard]] T condition_number_estimate() const
+  {
+    int const n = size();
+    if (n == 0) return T(0);
+    if (m_is_singular) return std::numeric_limits<T>::infinity();
+    std::vector<T> x(std::size_t(n), T(1) / T(n));
+    std::vector<T> z(static_cast<std::size_t>(n));
+    T inverse_norm = T(0);
+    int previous_j = -1;
+    for (int iteration = 0; iteration < 5; ++iteration) {
+      std::vector<T> y = x;
+      solve_vector(y, false);
+      inverse_norm = T(0);
+      for (int i = 0; i < n; ++i) {
+        inverse_norm += p3a::abs(y[i]);
+        z[i] = (y[i] < T(0)) ? T(-1) : T(1);
+      }
+      solve_vector(z, true);
+      int j = 0;
+      T z_dot_x = T(0);
+      for (int i = 0; i < n; ++i) {
+        z_dot_x += z[i] * x[i];
+        if (p3a::abs(z[i]) > p3a::abs(z[j])) j = i;
+      }
+      if (p3a::abs(z[j]) <= z_dot_x || j == previous_j) break;
+      std::fill(x.begin(), x.end(), T(0));
+      x[j] = T(1);
+      previous_j = j;
+    }
+    return m_norm * inverse_norm;
+  }
+ private:
+  void factor_in_place()
+  {
+    int const n = m_factors.row_count();
+    if (m_factors.column_count() != n) {
+      throw std::invalid_argument("LU factorization: matrix not square");
+    }
+    m_pivots.resize(std::size_t(n));
+    m_pivot_sign = 1;
+    m_is_singular = false;
+    m_norm = T(0);
+    for (int j = 0; j < n; ++j) {
+      T column_sum = T(0);
+      for (int i = 0; i < n; ++i) column_sum += p3a::abs(m_factors(i, j));
+      m_norm = p3a::max(m_norm, column_sum);
+    }
+    auto& a = m_factors;
+    for (int k0 = 0; k0 < n; k0 += m_block_size) {
+      int const k1 = p3a::min(n, k0 + m_block_size);
+      factor_panel(k0, k1);
+      if (k1 == n) break;
+      // U12 = L11^{-1} A12, one independent column per thread
+      T* const lu = a.data();
+      for_each(a.get_execution_policy(),
+          counting_iterator<int>(k1),
+          counting_iterator<int>(n),
+      [=] P3A_HOST_DEVICE (int j) P3A_ALWAYS_INLINE {
+        for (int k = k0; k < k1; ++k) {
+          T const u_kj = lu[k * n + j];
+          for (int i = k + 1; i < k1; ++i) {
+            lu[i * n + j] -= lu[i * n + k] * u_kj;
+          }
+        }
+      });
+      // A22 = A22 - L21 U12
+      auto const factors = std::as_const(a).view();
+      details::gemm(T(-1),
+          factors.submatrix(k1, k0, n - k1, k1 - k0),
+          factors.submatrix(k0, k1, k1 - k0, n - k1),
+          T(1), a.view().submatrix(k1, k1, n - k1, n - k1));
+    }
+  }
+  // unblocked factorization of columns [k0, k1), rows [k0, n).
+  // row interchanges are applied to entire rows.
+  void factor_panel(int k0, int k1)
+  {
+    auto& a = m_factors;
+    int const n = a.row_count();
+    for (int k = k0; k < k1; ++k) {
+      int pivot = k;
+      T max_magnitude = p3a::abs(a(k, k));
+      for (int i = k + 1; i < n; ++i) {
+        T const magnitude = p3a::abs(a(i, k));
+        if (magnitude > max_magnitude) {
+          pivot = i;
+          max_magnitude = magnitude;
+        }
+      }
+      m_pivots[std::size_t(k)] = pivot;
+      if (pivot != k) {
+        swap_rows(a, k, pivot);
+        m_pivot_sign = -m_pivot_sign;
+      }
+      if (max_magnitude == T(0)) {
+        m_is_singular = true;
+        continue;
+      }
+      T const inverse_pivot = T(1) / a(k, k);
+      for (int i = k + 1; i < n; ++i) {
+        T const l_ik = a(i, k) * inverse_pivot;
+        a(i, k) = l_ik;
+        for (int j = k + 1; j < k1; ++j) {
+          a(i, j) -= l_ik * a(k, j);
+        }
+      }
+    }
+  }
+  // solves A x = b, or A^T x = b if transposed, for a single host vector
+  void solve_vector(std::vector<T>& x, bool transposed) const
+  {
+    int const n = size();
+    auto const& a = m_factors;
+    if (!transposed) {
+      for (int k = 0; k < n; ++k) std::swap(x[k], x[m_pivots[k]]);
+      for (int i = 1; i < n; ++i) {
+        for (int k = 0; k < i; ++k) x[i] -= a(i, k) * x[k];
+      }
+      for (int i = n - 1; i >= 0; --i) {
+        for (int k = i + 1; k < n; ++k) x[i] -= a(i, k) * x[k];
+        x[i] /= a(i, i);
+      }
+    } else {
+      // A^T = U^T L^T P
+      for (int i = 0; i < n; ++i) {
+        for (int k = 0; k < i; ++k) x[i] -= a(k, i) * x[k];
+        x[i] /= a(i, i);
+      }
+      for (int i = n - 2; i >= 0; --i) {
+        for (int k = i + 1; k < n; ++k) x[i] -= a(k, i) * x[k];
+      }
+      for (int k = n - 1; k >= 0; --k) std::swap(x[k], x[m_pivots[k]]);
+    }
+  }
+};
+
+}
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cassert>
+
 #include "p3a_macros.hpp"
+#include "p3a_constants.hpp"
+#include "p3a_functions.hpp"
 #include "p3a_diagonal3x3.hpp"
 #include "p3a_vector3.hpp"
 #include "p3a_symmetric3x3.hpp"
@@ -8,6 +12,7 @@
 #include "p3a_mandel6x1.hpp"
 #include "p3a_static_vector.hpp"
 #include "p3a_static_matrix.hpp"
+#include "p3a_static_matrix_solve.hpp"
 
 /********************************* NOTES ************************************
  * This header provides the class: 
@@ -755,6 +760,203 @@ mandel6x6<U> inverse(
     return mandel6x6<U>(ainv,true);
 }
 
+namespace details {
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+static_matrix<T, 6, 6> to_static_matrix(
+    mandel6x6<T> const& a)
+{
+  static_matrix<T, 6, 6> result;
+  result(0,0) = a.x11();
+  result(0,1) = a.x12();
+  result(0,2) = a.x13();
+  result(0,3) = a.x14();
+  result(0,4) = a.x15();
+  result(0,5) = a.x16();
+  result(1,0) = a.x21();
+  result(1,1) = a.x22();
+  result(1,2) = a.x23();
+  result(1,3) = a.x24();
+  result(1,4) = a.x25();
+  result(1,5) = a.x26();
+  result(2,0) = a.x31();
+  result(2,1) = a.x32();
+  result(2,2) = a.x33();
+  result(2,3) = a.x34();
+  result(2,4) = a.x35();
+  result(2,5) = a.x36();
+  result(3,0) = a.x41();
+  result(3,1) = a.x42();
+  result(3,2) = a.x43();
+  result(3,3) = a.x44();
+  result(3,4) = a.x45();
+  result(3,5) = a.x46();
+  result(4,0) = a.x51();
+  result(4,1) = a.x52();
+  result(4,2) = a.x53();
+  result(4,3) = a.x54();
+  result(4,4) = a.x55();
+  result(4,5) = a.x56();
+  result(5,0) = a.x61();
+  result(5,1) = a.x62();
+  result(5,2) = a.x63();
+  result(5,3) = a.x64();
+  result(5,4) = a.x65();
+  result(5,5) = a.x66();
+  return result;
+}
+
+}
+
+//inverse of a symmetric positive definite tensor by Cholesky factorization,
+//with the same conventions as inverse() but no pivoting, row scaling or
+//branching on data. only the lower triangle of V is read.
+template <class U>
+[[nodiscard]] P3A_HOST_DEVICE inline
+mandel6x6<U> inverse_spd(
+    mandel6x6<U> const &V)
+{
+    mandel6x6<U> T(V);
+    T.invMandelXform();
+    auto w = details::to_static_matrix(T);
+    (void)cholesky_inverse(w);
+    return mandel6x6<U>(w,true);
+}
+
+//stiffness of a material with cubic symmetry aligned with the axes,
+//given by the Voigt moduli c11, c12 and c44
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+mandel6x6<T> cubic_mandel6x6(
+    T const& c11, T const& c12, T const& c44)
+{
+    return mandel6x6<T>(
+        c11,  c12,  c12,  T(0), T(0), T(0),
+        c12,  c11,  c12,  T(0), T(0), T(0),
+        c12,  c12,  c11,  T(0), T(0), T(0),
+        T(0), T(0), T(0), c44,  T(0), T(0),
+        T(0), T(0), T(0), T(0), c44,  T(0),
+        T(0), T(0), T(0), T(0), T(0), c44);
+}
+
+//stiffness of an isotropic material given by its bulk and shear moduli
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+mandel6x6<T> isotropic_mandel6x6(
+    T const& bulk, T const& shear)
+{
+    return cubic_mandel6x6(
+        bulk + T(4.0/3.0) * shear, bulk - T(2.0/3.0) * shear, shear);
+}
+
+//closed-form inverse(cubic_mandel6x6(c11, c12, c44)): the normal block
+//(c11 - c12) I + c12 1 1^T is inverted by the Sherman-Morrison formula
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+mandel6x6<T> inverse_cubic(
+    T const& c11, T const& c12, T const& c44)
+{
+    T const d = T(1) / ((c11 - c12) * (c11 + T(2) * c12));
+    T const s11 = (c11 + c12) * d;
+    T const s12 = -c12 * d;
+    T const s44 = T(1) / c44;
+    return mandel6x6<T>(
+        s11,  s12,  s12,  T(0), T(0), T(0),
+        s12,  s11,  s12,  T(0), T(0), T(0),
+        s12,  s12,  s11,  T(0), T(0), T(0),
+        T(0), T(0), T(0), s44,  T(0), T(0),
+        T(0), T(0), T(0), T(0), s44,  T(0),
+        T(0), T(0), T(0), T(0), T(0), s44);
+}
+
+//closed-form inverse(isotropic_mandel6x6(bulk, shear))
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+mandel6x6<T> inverse_isotropic(
+    T const& bulk, T const& shear)
+{
+    T const s11 = T(1.0/9.0) / bulk + T(1.0/3.0) / shear;
+    T const s12 = T(1.0/9.0) / bulk - T(1.0/6.0) / shear;
+    T const s44 = T(1) / shear;
+    return mandel6x6<T>(
+        s11,  s12,  s12,  T(0), T(0), T(0),
+        s12,  s11,  s12,  T(0), T(0), T(0),
+        s12,  s12,  s11,  T(0), T(0), T(0),
+        T(0), T(0), T(0), s44,  T(0), T(0),
+        T(0), T(0), T(0), T(0), s44,  T(0),
+        T(0), T(0), T(0), T(0), T(0), s44);
+}
+
+//what the caller knows about a tensor to be inverted, which selects
+//the cheapest correct algorithm in inverse(V, symmetry)
+enum class mandel6x6_symmetry {
+  general,
+  positive_definite,
+  cubic,
+  isotropic,
+};
+
+namespace details {
+
+//whether V has the form of cubic_mandel6x6, up to rounding
+template <class U>
+[[nodiscard]] P3A_HOST_DEVICE inline
+bool has_cubic_symmetry(mandel6x6<U> const &V)
+{
+    U const tolerance = U(1000) * epsilon_value<U>();
+    U const zero = tolerance * (p3a::abs(V.x11()) + p3a::abs(V.x44()));
+    auto const is_zero = [=] (U const& x) { return p3a::abs(x) <= zero; };
+    return
+        are_close(V.x11(), V.x22(), tolerance) && are_close(V.x11(), V.x33(), tolerance) &&
+        are_close(V.x12(), V.x13(), tolerance) && are_close(V.x12(), V.x21(), tolerance) &&
+        are_close(V.x12(), V.x23(), tolerance) && are_close(V.x12(), V.x31(), tolerance) &&
+        are_close(V.x12(), V.x32(), tolerance) &&
+        are_close(V.x44(), V.x55(), tolerance) && are_close(V.x44(), V.x66(), tolerance) &&
+        is_zero(V.x14()) && is_zero(V.x15()) && is_zero(V.x16()) &&
+        is_zero(V.x24()) && is_zero(V.x25()) && is_zero(V.x26()) &&
+        is_zero(V.x34()) && is_zero(V.x35()) && is_zero(V.x36()) &&
+        is_zero(V.x41()) && is_zero(V.x42()) && is_zero(V.x43()) &&
+        is_zero(V.x51()) && is_zero(V.x52()) && is_zero(V.x53()) &&
+        is_zero(V.x61()) && is_zero(V.x62()) && is_zero(V.x63()) &&
+        is_zero(V.x45()) && is_zero(V.x46()) && is_zero(V.x54()) &&
+        is_zero(V.x56()) && is_zero(V.x64()) && is_zero(V.x65());
+}
+
+//whether V has the form of isotropic_mandel6x6, up to rounding:
+//cubic symmetry with c44 = (c11 - c12) / 2
+template <class U>
+[[nodiscard]] P3A_HOST_DEVICE inline
+bool has_isotropic_symmetry(mandel6x6<U> const &V)
+{
+    return has_cubic_symmetry(V) &&
+        are_close(V.x44(), V.x11() - V.x12(), U(1000) * epsilon_value<U>());
+}
+
+}
+
+//the symmetry is only checked by assertions in debug builds
+template <class U>
+[[nodiscard]] P3A_HOST_DEVICE inline
+mandel6x6<U> inverse(
+    mandel6x6<U> const &V,
+    mandel6x6_symmetry symmetry)
+{
+    switch (symmetry) {
+      case mandel6x6_symmetry::positive_definite:
+        return inverse_spd(V);
+      case mandel6x6_symmetry::cubic:
+        assert(details::has_cubic_symmetry(V));
+        return inverse_cubic(V.x11(), V.x12(), V.x44() / V.two);
+      case mandel6x6_symmetry::isotropic:
+        assert(details::has_isotropic_symmetry(V));
+        return inverse_isotropic(
+            (V.x11() + U(2) * V.x12()) / U(3), V.x44() / V.two);
+      default:
+        return inverse(V);
+    }
+}
+
 /** Create a 6x6 Mandel Tensor to Rotate a 6x6 Mandel Tensor
  *
  *	Convert 3x3 rotation operator to rotation operator for Mandel Vectors.
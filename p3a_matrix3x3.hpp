@@ -289,9 +289,9 @@ template <typename T>
 [[nodiscard]] P3A_HOST_DEVICE inline auto
 norm_1(matrix3x3<T> const& A)
 {
-  auto const v0 = p3a::abs(A(0, 0) + A(1, 0) + A(2, 0));
-  auto const v1 = p3a::abs(A(0, 1) + A(1, 1) + A(2, 1));
-  auto const v2 = p3a::abs(A(0, 2) + A(1, 2) + A(2, 2));
+  auto const v0 = p3a::abs(A(0, 0)) + p3a::abs(A(1, 0)) + p3a::abs(A(2, 0));
+  auto const v1 = p3a::abs(A(0, 1)) + p3a::abs(A(1, 1)) + p3a::abs(A(2, 1));
+  auto const v2 = p3a::abs(A(0, 2)) + p3a::abs(A(1, 2)) + p3a::abs(A(2, 2));
   return p3a::max(p3a::max(v0, v1), v2);
 }
 
@@ -300,10 +300,10 @@ template <typename T>
 [[nodiscard]] P3A_HOST_DEVICE inline auto
 norm_infinity(matrix3x3<T> const& A)
 {
-  auto const v0 = p3a::abs(A(0, 0) + A(0, 1) + A(0, 2));
-  auto const v1 = p3a::abs(A(1, 0) + A(1, 1) + A(1, 2));
-  auto const v2 = p3a::abs(A(2, 0) + A(2, 1) + A(2, 2));
-  return max(max(v0, v1), v2);
+  auto const v0 = p3a::abs(A(0, 0)) + p3a::abs(A(0, 1)) + p3a::abs(A(0, 2));
+  auto const v1 = p3a::abs(A(1, 0)) + p3a::abs(A(1, 1)) + p3a::abs(A(1, 2));
+  auto const v2 = p3a::abs(A(2, 0)) + p3a::abs(A(2, 1)) + p3a::abs(A(2, 2));
+  return p3a::max(p3a::max(v0, v1), v2);
 }
 
 template <class T>
@@ -430,6 +430,60 @@ void store(
   store(value.zz(), ptr, 8 * stride + offset);
 }
 
+template <class T, class U, class Abi>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+auto load_matrix3x3(T const* ptr, int stride, int offset, simd_mask<U, Abi> const& mask)
+{
+  auto const a = load(ptr, 0 * stride + offset, mask);
+  auto const b = load(ptr, 1 * stride + offset, mask);
+  auto const c = load(ptr, 2 * stride + offset, mask);
+  auto const d = load(ptr, 3 * stride + offset, mask);
+  auto const e = load(ptr, 4 * stride + offset, mask);
+  auto const f = load(ptr, 5 * stride + offset, mask);
+  auto const g = load(ptr, 6 * stride + offset, mask);
+  auto const h = load(ptr, 7 * stride + offset, mask);
+  auto const i = load(ptr, 8 * stride + offset, mask);
+  using loaded_scalar_type = std::remove_const_t<decltype(a)>;
+  return matrix3x3<loaded_scalar_type>(a, b, c, d, e, f, g, h, i);
+}
+
+template <class T, class U, class V, class Abi>
+P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+void store(
+    matrix3x3<T> const& value,
+    U* ptr, int stride, int offset, simd_mask<V, Abi> const& mask)
+{
+  store(value.xx(), ptr, 0 * stride + offset, mask);
+  store(value.xy(), ptr, 1 * stride + offset, mask);
+  store(value.xz(), ptr, 2 * stride + offset, mask);
+  store(value.yx(), ptr, 3 * stride + offset, mask);
+  store(value.yy(), ptr, 4 * stride + offset, mask);
+  store(value.yz(), ptr, 5 * stride + offset, mask);
+  store(value.zx(), ptr, 6 * stride + offset, mask);
+  store(value.zy(), ptr, 7 * stride + offset, mask);
+  store(value.zz(), ptr, 8 * stride + offset, mask);
+}
+
+template <class T, class Mask>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline constexpr
+std::enable_if_t<!std::is_same_v<Mask, bool>, matrix3x3<T>>
+condition(
+    Mask const& a,
+    matrix3x3<T> const& b,
+    matrix3x3<T> const& c)
+{
+  return matrix3x3<T>(
+    condition(a, b.xx(), c.xx()),
+    condition(a, b.xy(), c.xy()),
+    condition(a, b.xz(), c.xz()),
+    condition(a, b.yx(), c.yx()),
+    condition(a, b.yy(), c.yy()),
+    condition(a, b.yz(), c.yz()),
+    condition(a, b.zx(), c.zx()),
+    condition(a, b.zy(), c.zy()),
+    condition(a, b.zz(), c.zz()));
+}
+
 template <class A, class B>
 [[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline constexpr
 auto multiply_at_b_a(
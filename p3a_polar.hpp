@@ -3,6 +3,10 @@
 // functions for polar decomposition of 3x3 tensors
 
 #include "p3a_matrix3x3.hpp"
+#include "p3a_tensor_expression.hpp"
+#include "p3a_simd.hpp"
+#include "p3a_for_each.hpp"
+#include "p3a_counting_iterator.hpp"
 
 namespace p3a {
 
@@ -75,7 +79,7 @@ polar_errc polar_rotation_fast(
   // trace[C].  Complete computation of [E]=(1/2)([C]-[I]) with [C] now being
   // scaled.
   T scale = T(3.0) / trace(E);
-  E = (E * scale - identity) * T(0.5);
+  E = evaluate((lazy(E) * scale - identity) * T(0.5));
   // First guess for [R] equal to the scaled [F] matrix,
   // [A]=Sqrt[3]F/magnitude[F]
   scale = p3a::sqrt(scale);
@@ -92,9 +96,9 @@ polar_errc polar_rotation_fast(
   matrix3x3<T> X;
   for (int it=0; it<maxit; it++)
   {
-    X = A * (identity - E);
+    X = A * evaluate(lazy(identity) - E);
     A = X;
-    E = (transpose(A) * A - identity) * T(0.5);
+    E = evaluate((lazy(transpose(A) * A) - identity) * T(0.5));
     T err2 = E.xx() * E.xx() + E.yy() * E.yy() + E.zz() * E.zz()
            + T(2.0) * (E.xy() * E.xy() + E.yz() * E.yz() + E.zx() * E.zx());
     // If new error is smaller than old error, then keep on iterating.  If new
@@ -110,6 +114,142 @@ polar_errc polar_rotation_fast(
   return polar_errc::no_converge;
 }
 
+// per-lane outcome of masked_polar_rotation_fast, one mask per
+// polar_errc other than success
+template <class Mask>
+struct polar_status {
+  Mask singular;
+  Mask no_converge;
+};
+
+// polar_rotation_fast for T that may be a SIMD type, with one matrix per lane.
+// lanes that are singular or have converged stop changing while the others
+// keep iterating, so the loop runs until every lane is done or maxit is hit.
+// R is meaningless in lanes where either mask of the result is true.
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE inline
+auto masked_polar_rotation_fast(
+    matrix3x3<T> const& F,
+    matrix3x3<T>& R,
+    const int maxit=200)
+{
+  using mask_type = decltype(T() < T());
+  matrix3x3<T> const identity{
+    T(1.0), T(0.0), T(0.0),
+    T(0.0), T(1.0), T(0.0),
+    T(0.0), T(0.0), T(1.0)
+  };
+  mask_type const singular = !(determinant(F) > T(0.0));
+  auto E = transpose(F) * F;
+  // see polar_rotation_fast for the scaling; singular lanes get a harmless one
+  T const trace_E = trace(E);
+  T scale = T(3.0) / condition(trace_E > T(0.0), trace_E, T(1.0));
+  E = evaluate((lazy(E) * scale - identity) * T(0.5));
+  scale = p3a::sqrt(scale);
+  auto A = scale * F;
+  T err1 = E.xx() * E.xx() + E.yy() * E.yy() + E.zz() * E.zz()
+         + T(2.0) * (E.xy() * E.xy() + E.yz() * E.yz() + E.zx() * E.zx());
+  mask_type done = singular || (err1 + T(1.0) == T(1.0));
+  for (int it=0; it<maxit; it++)
+  {
+    if (all_of(done)) break;
+    auto const active = !done;
+    auto const X = A * evaluate(lazy(identity) - E);
+    auto const E2 = evaluate((lazy(transpose(X) * X) - identity) * T(0.5));
+    T const err2 = E2.xx() * E2.xx() + E2.yy() * E2.yy() + E2.zz() * E2.zz()
+           + T(2.0) * (E2.xy() * E2.xy() + E2.yz() * E2.yz() + E2.zx() * E2.zx());
+    A = condition(active, X, A);
+    E = condition(active, E2, E);
+    done = done || (err2 >= err1) || (err2 + T(1.0) == T(1.0));
+    err1 = condition(active, err2, err1);
+  }
+  R = A;
+  return polar_status<mask_type>{singular, !done};
+}
+
+namespace details {
+
+template <class T, class Abi>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void store_polar_status(
+    polar_status<simd_mask<T, Abi>> const& status,
+    simd_mask<T, Abi> const& mask,
+    polar_errc* errors,
+    int offset)
+{
+  for (int lane = 0; lane < int(simd_mask<T, Abi>::size()); ++lane) {
+    if (!mask[lane]) continue;
+    errors[offset + lane] =
+      status.singular[lane] ? polar_errc::singular :
+      (status.no_converge[lane] ? polar_errc::no_converge : polar_errc::success);
+  }
+}
+
+}
+
+// right polar decompositions F = R U of count matrices stored in
+// structure-of-arrays layout, entry (i, j) of matrix s being
+// F[(3 * i + j) * count + s], one matrix per SIMD lane.
+// R uses the same layout, U is stored as xx, xy, xz, yy, yz, zz with the
+// same stride, and errors[s] receives the outcome for matrix s.
+template <class T, class ExecutionPolicy>
+P3A_NEVER_INLINE
+void batched_decompose_polar_right(
+    ExecutionPolicy policy,
+    int count,
+    T const* F,
+    T* R,
+    T* U,
+    polar_errc* errors)
+{
+  using abi_type = typename ExecutionPolicy::simd_abi_type;
+  using simd_type = simd<T, abi_type>;
+  using mask_type = simd_mask<T, abi_type>;
+  simd_for_each<T>(policy,
+      counting_iterator<int>(0),
+      counting_iterator<int>(count),
+  [=] P3A_HOST_DEVICE (int s, mask_type const& mask) P3A_ALWAYS_INLINE {
+    // inactive lanes get the identity so they converge immediately
+    matrix3x3<simd_type> const F_s = condition(mask,
+        load_matrix3x3(F, count, s, mask),
+        matrix3x3<simd_type>::identity());
+    matrix3x3<simd_type> R_s;
+    auto const status = masked_polar_rotation_fast(F_s, R_s);
+    store(R_s, R, count, s, mask);
+    store(symmetric_part(transpose(R_s) * F_s), U, count, s, mask);
+    details::store_polar_status(status, mask, errors, s);
+  });
+}
+
+// left polar decompositions F = V R, in the layout of batched_decompose_polar_right
+template <class T, class ExecutionPolicy>
+P3A_NEVER_INLINE
+void batched_decompose_polar_left(
+    ExecutionPolicy policy,
+    int count,
+    T const* F,
+    T* V,
+    T* R,
+    polar_errc* errors)
+{
+  using abi_type = typename ExecutionPolicy::simd_abi_type;
+  using simd_type = simd<T, abi_type>;
+  using mask_type = simd_mask<T, abi_type>;
+  simd_for_each<T>(policy,
+      counting_iterator<int>(0),
+      counting_iterator<int>(count),
+  [=] P3A_HOST_DEVICE (int s, mask_type const& mask) P3A_ALWAYS_INLINE {
+    matrix3x3<simd_type> const F_s = condition(mask,
+        load_matrix3x3(F, count, s, mask),
+        matrix3x3<simd_type>::identity());
+    matrix3x3<simd_type> R_s;
+    auto const status = masked_polar_rotation_fast(F_s, R_s);
+    store(R_s, R, count, s, mask);
+    store(symmetric_part(F_s * transpose(R_s)), V, count, s, mask);
+    details::store_polar_status(status, mask, errors, s);
+  });
+}
+
 // Project to O(N) (Orthogonal Group) using a Newton-type algorithm.
 // See Higham's Functions of Matrices p210 [2008]
 // \param A tensor (often a deformation-gradient-like tensor)
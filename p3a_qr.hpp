@@ -0,0 +1,318 @@
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "p3a_dynamic_matrix.hpp"
+#include "p3a_static_matrix.hpp"
+#include "p3a_static_vector.hpp"
+#include "p3a_static_matrix_solve.hpp"
+#include "p3a_simd.hpp"
+#include "p3a_for_each.hpp"
+#include "p3a_counting_iterator.hpp"
+
+namespace p3a {
+
+/* Householder QR factorization A = Q R of an m x n matrix with m >= n,
+   mainly for solving least squares problems without forming the
+   normal equations, whose condition number is the square of that of A.
+   Factorization is blocked: each panel of columns is reduced with
+   unblocked Householder reflections on the host, and the panel's
+   reflectors are then accumulated into the compact WY form
+   I - V T V^T (Schreiber and Van Loan, 1989), which is applied to the
+   trailing columns with three parallel GEMMs.
+   As in LAPACK's geqrf, factors() holds R on and above the diagonal and
+   the Householder vectors, whose leading unit entries are implicit, below it. */
+
+template <
+  class T,
+  class Allocator = host_allocator<T>,
+  class ExecutionPolicy = execution::sequenced_policy>
+class qr_factorization {
+ public:
+  using matrix_type = dynamic_matrix<T, Allocator, ExecutionPolicy>;
+ private:
+  matrix_type m_factors;
+  std::vector<T> m_tau;
+  std::vector<matrix_type> m_block_triangles;
+  std::vector<int> m_block_begins;
+  matrix_type m_reflectors;
+  matrix_type m_product;
+  matrix_type m_scaled_product;
+  int m_block_size = 32;
+ public:
+  qr_factorization() = default;
+  explicit qr_factorization(matrix_type const& a)
+  {
+    factor(a);
+  }
+  void set_block_size(int block_size_arg)
+  {
+    if (block_size_arg < 1) {
+      throw std::invalid_argument("QR factorization: block size must be positive");
+    }
+    m_block_size = block_size_arg;
+  }
+  void factor(matrix_type const& a)
+  {
+    m_factors = a;
+    factor_in_place();
+  }
+  void factor(matrix_type&& a)
+  {
+    m_factors = std::move(a);
+    factor_in_place();
+  }
+  [[nodiscard]] int row_count() const { return m_factors.row_count(); }
+  [[nodiscard]] int column_count() const { return m_factors.column_count(); }
+  [[nodiscard]] matrix_type const& factors() const { return m_factors; }
+  // B = Q^T B
+  void apply_q_transpose(matrix_type& b)
+  {
+    check_rows(b);
+    int const block_count = int(m_block_triangles.size());
+    for (int block = 0; block < block_count; ++block) {
+      apply_block_reflector(block, true, b, 0);
+    }
+  }
+  // B = Q B
+  void apply_q(matrix_type& b)
+  {
+    check_rows(b);
+    int const block_count = int(m_block_triangles.size());
+    for (int block = block_count - 1; block >= 0; --block) {
+      apply_block_reflector(block, false, b, 0);
+    }
+  }
+  // X = argmin ||A X - B||_2, solved for every column of B at once
+  void least_squares_solve(matrix_type const& b, matrix_type& x)
+  {
+    int const n = column_count();
+    matrix_type qtb = b;
+    apply_q_transpose(qtb);
+    for (int i = 0; i < n; ++i) {
+      if (m_factors(i, i) == T(0)) {
+        throw std::invalid_argument("QR least squares: matrix is rank deficient");
+      }
+    }
+    int const rhs_count = b.column_count();
+    x.resize(n, rhs_count);
+    T const* const r = m_factors.data();
+    T const* const y = qtb.data();
+    T* const x_ptr = x.data();
+    for_each(x.get_execution_policy(),
+        counting_iterator<int>(0),
+        counting_iterator<int>(rhs_count),
+    [=] P3A_HOST_DEVICE (int j) P3A_ALWAYS_INLINE {
+      for (int i = n - 1; i >= 0; --i) {
+        T sum = y[i * rhs_count + j];
+        for (int k = i + 1; k < n; ++k) {
+          sum -= r[i * n + k] * x_ptr[k * rhs_count + j];
+        }
+        x_ptr[i * rhs_count + j] = sum / r[i * n + i];
+      }
+    });
+  }
+ private:
+  void check_rows(matrix_type const& b) const
+  {
+    if (b.row_count() != row_count()) {
+      throw std::invalid_argument("QR: A rows != B rows");
+    }
+  }
+  void factor_in_place()
+  {
+    int const m = m_factors.row_count();
+    int const n = m_factors.column_count();
+    if (m < n) {
+      throw std::invalid_argument("QR factorization: fewer rows than columns");
+    }
+    auto& a = m_factors;
+    m_tau.assign(std::size_t(n), T(0));
+    m_block_triangles.clear();
+    m_block_begins.clear();
+    for (int k0 = 0; k0 < n; k0 += m_block_size) {
+      int const k1 = p3a::min(n, k0 + m_block_size);
+      for (int j = k0; j < k1; ++j) {
+        T const tau = make_reflector(j);
+        m_tau[std::size_t(j)] = tau;
+        if (tau == T(0)) continue;
+        for (int c = j + 1; c < k1; ++c) {
+          T w = a(j, c);
+          for (int i = j + 1; i < m; ++i) w += a(i, j) * a(i, c);
+          w *= tau;
+          a(j, c) -= w;
+          for (int i = j + 1; i < m; ++i) a(i, c) -= a(i, j) * w;
+        }
+      }
+      m_block_triangles.push_back(form_block_triangle(k0, k1));
+      m_block_begins.push_back(k0);
+      if (k1 < n) {
+        apply_block_reflector(int(m_block_triangles.size()) - 1, true, a, k1);
+      }
+    }
+  }
+  // computes the reflector H = I - tau v v^T that maps a(j:m, j) to beta e_1,
+  // storing beta in a(j, j) and v(1:) below it (LAPACK's larfg)
+  T make_reflector(int j)
+  {
+    auto& a = m_factors;
+    int const m = a.row_count();
+    T const alpha = a(j, j);
+    T sigma = T(0);
+    for (int i = j + 1; i < m; ++i) sigma += square(a(i, j));
+    if (sigma == T(0)) return T(0);
+    T const norm = p3a::sqrt(square(alpha) + sigma);
+    T const beta = (alpha < T(0)) ? norm : -norm;
+    T const inverse_scale = T(1) / (alpha - beta);
+    for (int i = j + 1; i < m; ++i) a(i, j) *= inverse_scale;
+    a(j, j) = beta;
+    return (beta - alpha) / beta;
+  }
+  // the upper triangular T of H_k0 ... H_{k1-1} = I - V T V^T (LAPACK's larft)
+  matrix_type form_block_triangle(int k0, int k1)
+  {
+    auto const& a = m_factors;
+    int const m = a.row_count();
+    int const kb = k1 - k0;
+    matrix_type t(kb, kb);
+    t.assign_zero();
+    for (int j = 0; j < kb; ++j) {
+      T const tau = m_tau[std::size_t(k0 + j)];
+      t(j, j) = tau;
+      for (int i = 0; i < j; ++i) {
+        // v_i^T v_j, where v_i has a unit entry at row k0 + i
+        T dot = a(k0 + j, k0 + i);
+        for (int l = k0 + j + 1; l < m; ++l) dot += a(l, k0 + i) * a(l, k0 + j);
+        t(i, j) = -tau * dot;
+      }
+      for (int i = 0; i < j; ++i) {
+        T sum = T(0);
+        for (int l = i; l < j; ++l) sum += t(i, l) * t(l, j);
+        t(i, j) = sum;
+      }
+    }
+    return t;
+  }
+  // C = (I - V T^T V^T) C if transposed, C = (I - V T V^T) C otherwise,
+  // where C is rows [k0, m) and columns [column_begin, n) of c
+  void apply_block_reflector(int block, bool transposed, matrix_type& c, int column_begin)
+  {
+    auto const& a = m_factors;
+    auto const& t = m_block_triangles[std::size_t(block)];
+    int const m = a.row_count();
+    int const k0 = m_block_begins[std::size_t(block)];
+    int const kb = t.row_count();
+    int const mv = m - k0;
+    int const nc = c.column_count() - column_begin;
+    if (nc <= 0) return;
+    m_reflectors.resize(mv, kb);
+    for (int i = 0; i < mv; ++i) {
+      for (int j = 0; j < kb; ++j) {
+        m_reflectors(i, j) = (i > j) ? a(k0 + i, k0 + j) : T(i == j);
+      }
+    }
+    auto const c_block = c.view().submatrix(k0, column_begin, mv, nc);
+    auto const v = std::as_const(m_reflectors).view();
+    m_product.resize(kb, nc);
+    m_scaled_product.resize(kb, nc);
+    // W = V^T C
+    details::gemm(T(1), v.transpose(), std::as_const(c).view().submatrix(k0, column_begin, mv, nc),
+        T(0), m_product.view());
+    // W = T^T W or T W
+    details::gemm(T(1), transposed ? t.view().transpose() : t.view(),
+        std::as_const(m_product).view(),
+        T(0), m_scaled_product.view());
+    // C = C - V W
+    details::gemm(T(-1), v, std::as_const(m_scaled_product).view(),
+        T(1), c_block);
+  }
+};
+
+// solves the M x N least squares problem min ||A x - b||_2 with M >= N by
+// unblocked Householder QR, for a scalar or one problem per SIMD lane.
+// a is overwritten with its factors and b with Q^T b.
+// returns, per lane, whether R has a zero on its diagonal, in which case
+// that lane's solution is meaningless.
+template <class T, int M, int N>
+[[nodiscard]] P3A_HOST_DEVICE inline
+auto householder_least_squares(
+    static_matrix<T, M, N>& a,
+    static_vector<T, M>& b,
+    static_vector<T, N>& x)
+{
+  static_assert(M >= N, "least squares needs at least as many rows as columns");
+  using mask_type = decltype(T() < T());
+  mask_type rank_deficient(false);
+  for (int j = 0; j < N; ++j) {
+    T const alpha = a(j, j);
+    T sigma = T(0);
+    for (int i = j + 1; i < M; ++i) sigma += a(i, j) * a(i, j);
+    auto const is_identity = (sigma == T(0));
+    T const norm = p3a::sqrt(alpha * alpha + sigma);
+    T const beta = condition(is_identity, alpha, condition(alpha < T(0), norm, -norm));
+    T const tau = condition(is_identity, T(0), (beta - alpha) / condition(is_identity, T(1), beta));
+    T const inverse_scale = T(1) / condition(is_identity, T(1), alpha - beta);
+    for (int i = j + 1; i < M; ++i) a(i, j) *= inverse_scale;
+    a(j, j) = beta;
+    for (int c = j + 1; c < N; ++c) {
+      T w = a(j, c);
+      for (int i = j + 1; i < M; ++i) w += a(i, j) * a(i, c);
+      w *= tau;
+      a(j, c) -= w;
+      for (int i = j + 1; i < M; ++i) a(i, c) -= a(i, j) * w;
+    }
+    T w = b[j];
+    for (int i = j + 1; i < M; ++i) w += a(i, j) * b[i];
+    w *= tau;
+    b[j] -= w;
+    for (int i = j + 1; i < M; ++i) b[i] -= a(i, j) * w;
+    auto const is_zero = (beta == T(0));
+    rank_deficient = rank_deficient || is_zero;
+    a(j, j) = condition(is_zero, T(1), beta);
+  }
+  for (int i = N - 1; i >= 0; --i) {
+    T sum = b[i];
+    for (int k = i + 1; k < N; ++k) sum -= a(i, k) * x[k];
+    x[i] = sum / a(i, i);
+  }
+  return rank_deficient;
+}
+
+// solves count independent M x N least squares problems, one per SIMD lane.
+// entry (i, j) of problem s is a[(i * N + j) * count + s], entry i of its
+// right hand side is b[i * count + s] and entry i of its solution is
+// written to x[i * count + s].
+// rank_deficient[s] tells whether problem s had linearly dependent columns,
+// in which case its solution is not the unique least squares minimizer.
+template <int M, int N, class T, class ExecutionPolicy>
+P3A_NEVER_INLINE
+void batched_least_squares(ExecutionPolicy policy, int count, T const* a, T const* b, T* x,
+    bool* rank_deficient)
+{
+  using abi_type = typename ExecutionPolicy::simd_abi_type;
+  using simd_type = simd<T, abi_type>;
+  using mask_type = simd_mask<T, abi_type>;
+  simd_for_each<T>(policy,
+      counting_iterator<int>(0),
+      counting_iterator<int>(count),
+  [=] P3A_HOST_DEVICE (int s, mask_type const& mask) P3A_ALWAYS_INLINE {
+    static_matrix<simd_type, M, N> a_s;
+    static_vector<simd_type, M> b_s;
+    static_vector<simd_type, N> x_s;
+    for (int i = 0; i < M; ++i) {
+      for (int j = 0; j < N; ++j) {
+        a_s(i, j) = condition(mask,
+            load(a, (i * N + j) * count + s, mask),
+            simd_type(T(i == j)));
+      }
+      b_s[i] = condition(mask, load(b, i * count + s, mask), simd_type(T(0)));
+    }
+    auto const failure = householder_least_squares(a_s, b_s, x_s);
+    details::store_batched_solution(x_s, x, count, s, mask);
+    details::store_batched_failure(failure, mask, rank_deficient, s);
+  });
+}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "p3a_quantity.hpp"
+#include "p3a_dynamic_array.hpp"
+#include "p3a_simd_view.hpp"
+
+namespace p3a {
+
+/* Arrays of quantities with compile-time units.
+
+   quantity<T, Unit> holds exactly one T and the unit is part of the type,
+   so an array of quantities is laid out as an array of plain values: the
+   unit costs no storage and no runtime work. The load() and store()
+   overloads in p3a_quantity.hpp already move whole SIMD batches between
+   such an array and quantity<simd<T, Abi>, Unit>, so a kernel written in
+   terms of quantities vectorizes exactly like one written on raw doubles.
+
+   quantity_simd_view gives Kokkos views of raw values the same treatment:
+   it forwards to simd_view and attaches the unit to what comes out. */
+
+template <
+  class T,
+  class Unit,
+  class Allocator = host_allocator<quantity<T, Unit>>,
+  class ExecutionPolicy = execution::sequenced_policy>
+using quantity_array = dynamic_array<quantity<T, Unit>, Allocator, ExecutionPolicy>;
+
+template <class T, class Unit>
+using device_quantity_array = quantity_array<T, Unit,
+      device_allocator<quantity<T, Unit>>, execution::parallel_policy>;
+
+static_assert(sizeof(quantity<double, kul::meter>) == sizeof(double),
+    "quantity arrays must be arrays of values");
+
+template <class DataType, class Unit>
+class quantity_simd_view {
+ public:
+  using view_type = simd_view<DataType>;
+  using value_type = typename Kokkos::View<DataType, Kokkos::LayoutLeft>::value_type;
+  using unit_type = Unit;
+  template <class Abi>
+  using quantity_type = quantity<simd<value_type, Abi>, Unit>;
+ private:
+  view_type m_view;
+ public:
+  quantity_simd_view() = default;
+  quantity_simd_view(Kokkos::View<DataType, Kokkos::LayoutLeft> view)
+    :m_view(view)
+  {}
+  quantity_simd_view(view_type const& view)
+    :m_view(view)
+  {}
+  [[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+  view_type const& values() const { return m_view; }
+  // load(i, ..., mask) with as many indices as the view has dimensions
+  template <class... Args>
+  [[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+  auto load(Args const&... args) const {
+    using simd_type = decltype(m_view.load(args...));
+    return quantity<simd_type, Unit>(m_view.load(args...));
+  }
+  template <class Abi, class... Args>
+  P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+  void store(quantity_type<Abi> const& q, Args const&... args) const {
+    m_view.store(q.value(), args...);
+  }
+  template <class Abi, class... Args>
+  P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+  void sum_store(quantity_type<Abi> const& q, Args const&... args) const {
+    m_view.sum_store(q.value(), args...);
+  }
+};
+
+}
@@ -0,0 +1,401 @@
+#pragma once
+
+#include "p3a_vector3.hpp"
+#include "p3a_matrix3x3.hpp"
+#include "p3a_axis_angle.hpp"
+#include "p3a_for_each.hpp"
+#include "p3a_counting_iterator.hpp"
+
+namespace p3a {
+
+/* this class represents a 3D rotation as a unit quaternion
+ * w + x i + y j + z k, where w = cos(angle / 2) and (x, y, z) is the
+ * axis of rotation times sin(angle / 2).
+ * everything below is branch-free, so T may be a SIMD type, and
+ * a rotation is stored in 4 values instead of the 9 of a matrix3x3.
+ */
+
+template <class T>
+class quaternion {
+  T m_w;
+  T m_x;
+  T m_y;
+  T m_z;
+ public:
+  P3A_ALWAYS_INLINE quaternion() = default;
+
+  P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+  quaternion(T const& w_arg, T const& x_arg, T const& y_arg, T const& z_arg)
+    :m_w(w_arg)
+    ,m_x(x_arg)
+    ,m_y(y_arg)
+    ,m_z(z_arg)
+  {}
+
+  P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+  quaternion(T const& w_arg, vector3<T> const& vector_arg)
+    :m_w(w_arg)
+    ,m_x(vector_arg.x())
+    ,m_y(vector_arg.y())
+    ,m_z(vector_arg.z())
+  {}
+
+  P3A_HOST_DEVICE inline explicit
+  quaternion(axis_angle<T> const& aa)
+  {
+    auto const angle = p3a::sqrt(magnitude_squared(aa.vector()));
+    auto const half_angle = T(0.5) * angle;
+    // sin(angle / 2) / angle, which tends to 1/2 as the angle vanishes
+    auto const is_small = (angle <= epsilon_value<scalar_type_t<T>>());
+    auto const safe_angle = condition(is_small, T(1.0), angle);
+    auto const factor = condition(is_small, T(0.5), p3a::sin(half_angle) / safe_angle);
+    m_w = p3a::cos(half_angle);
+    m_x = factor * aa.vector().x();
+    m_y = factor * aa.vector().y();
+    m_z = factor * aa.vector().z();
+  }
+
+/* Markley, F. Landis.
+   "Unit quaternion from rotation matrix."
+   Journal of guidance, control, and dynamics 31.2 (2008): 440-442.
+   Same choice of pivot as axis_angle(matrix3x3), made per lane with
+   condition() instead of branches */
+
+  P3A_HOST_DEVICE inline explicit
+  quaternion(matrix3x3<T> const& R)
+  {
+    T const trR = trace(R);
+    m_w = T(1.0) + trR;
+    m_x = R.zy() - R.yz();
+    m_y = R.xz() - R.zx();
+    m_z = R.yx() - R.xy();
+    T maxm = trR;
+    auto const is_x = (R.xx() > maxm);
+    maxm = condition(is_x, R.xx(), maxm);
+    m_w = condition(is_x, R.zy() - R.yz(), m_w);
+    m_x = condition(is_x, T(1.0) + R.xx() - R.yy() - R.zz(), m_x);
+    m_y = condition(is_x, R.xy() + R.yx(), m_y);
+    m_z = condition(is_x, R.xz() + R.zx(), m_z);
+    auto const is_y = (R.yy() > maxm);
+    maxm = condition(is_y, R.yy(), maxm);
+    m_w = condition(is_y, R.xz() - R.zx(), m_w);
+    m_x = condition(is_y, R.yx() + R.xy(), m_x);
+    m_y = condition(is_y, T(1.0) + R.yy() - R.zz() - R.xx(), m_y);
+    m_z = condition(is_y, R.yz() + R.zy(), m_z);
+    auto const is_z = (R.zz() > maxm);
+    m_w = condition(is_z, R.yx() - R.xy(), m_w);
+    m_x = condition(is_z, R.zx() + R.xz(), m_x);
+    m_y = condition(is_z, R.zy() + R.yz(), m_y);
+    m_z = condition(is_z, T(1.0) + R.zz() - R.xx() - R.yy(), m_z);
+    auto const inverse_norm = T(1.0) / p3a::sqrt(
+        square(m_w) + square(m_x) + square(m_y) + square(m_z));
+    m_w *= inverse_norm;
+    m_x *= inverse_norm;
+    m_y *= inverse_norm;
+    m_z *= inverse_norm;
+  }
+
+  [[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+  T const& w() const { return m_w; }
+  [[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+  T const& x() const { return m_x; }
+  [[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+  T const& y() const { return m_y; }
+  [[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+  T const& z() const { return m_z; }
+
+  [[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+  vector3<T> vector() const { return vector3<T>(m_x, m_y, m_z); }
+
+  [[nodiscard]] P3A_HOST_DEVICE inline
+  matrix3x3<T> tensor() const
+  {
+    auto const xx = m_x * m_x;
+    auto const yy = m_y * m_y;
+    auto const zz = m_z * m_z;
+    auto const xy = m_x * m_y;
+    auto const xz = m_x * m_z;
+    auto const yz = m_y * m_z;
+    auto const wx = m_w * m_x;
+    auto const wy = m_w * m_y;
+    auto const wz = m_w * m_z;
+    return matrix3x3<T>(
+        T(1.0) - T(2.0) * (yy + zz), T(2.0) * (xy - wz), T(2.0) * (xz + wy),
+        T(2.0) * (xy + wz), T(1.0) - T(2.0) * (xx + zz), T(2.0) * (yz - wx),
+        T(2.0) * (xz - wy), T(2.0) * (yz + wx), T(1.0) - T(2.0) * (xx + yy));
+  }
+
+  // the rotation vector of the shorter of the two equivalent rotations
+  [[nodiscard]] P3A_HOST_DEVICE inline
+  axis_angle<T> to_axis_angle() const
+  {
+    auto const is_negative = (m_w < T(0.0));
+    auto const w = condition(is_negative, -m_w, m_w);
+    auto const v = condition(is_negative, -vector(), vector());
+    auto const s = p3a::sqrt(magnitude_squared(v));
+    // asin is accurate for small angles and acos for those near pi
+    auto const half_angle = condition(s < w, p3a::asin(s), p3a::acos(w));
+    auto const is_small = (s <= epsilon_value<scalar_type_t<T>>());
+    auto const safe_s = condition(is_small, T(1.0), s);
+    auto const factor = condition(is_small, T(2.0), T(2.0) * half_angle / safe_s);
+    return axis_angle<T>(v * factor);
+  }
+
+  [[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE static constexpr
+  quaternion identity()
+  {
+    return quaternion(T(1.0), T(0.0), T(0.0), T(0.0));
+  }
+};
+
+template <class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+quaternion<T> operator+(quaternion<T> const& a, quaternion<T> const& b)
+{
+  return quaternion<T>(a.w() + b.w(), a.x() + b.x(), a.y() + b.y(), a.z() + b.z());
+}
+
+template <class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+quaternion<T> operator-(quaternion<T> const& a, quaternion<T> const& b)
+{
+  return quaternion<T>(a.w() - b.w(), a.x() - b.x(), a.y() - b.y(), a.z() - b.z());
+}
+
+template <class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+quaternion<T> operator-(quaternion<T> const& a)
+{
+  return quaternion<T>(-a.w(), -a.x(), -a.y(), -a.z());
+}
+
+template <class T, class B>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+typename std::enable_if<is_scalar<B>, quaternion<T>>::type
+operator*(quaternion<T> const& a, B const& b)
+{
+  return quaternion<T>(a.w() * b, a.x() * b, a.y() * b, a.z() * b);
+}
+
+template <class A, class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+typename std::enable_if<is_scalar<A>, quaternion<T>>::type
+operator*(A const& a, quaternion<T> const& b)
+{
+  return b * a;
+}
+
+template <class T, class B>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+typename std::enable_if<is_scalar<B>, quaternion<T>>::type
+operator/(quaternion<T> const& a, B const& b)
+{
+  return quaternion<T>(a.w() / b, a.x() / b, a.y() / b, a.z() / b);
+}
+
+// the Hamilton product: (a * b).tensor() == a.tensor() * b.tensor()
+template <class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+quaternion<T> operator*(quaternion<T> const& a, quaternion<T> const& b)
+{
+  return quaternion<T>(
+      a.w() * b.w() - a.x() * b.x() - a.y() * b.y() - a.z() * b.z(),
+      a.w() * b.x() + a.x() * b.w() + a.y() * b.z() - a.z() * b.y(),
+      a.w() * b.y() - a.x() * b.z() + a.y() * b.w() + a.z() * b.x(),
+      a.w() * b.z() + a.x() * b.y() - a.y() * b.x() + a.z() * b.w());
+}
+
+template <class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+quaternion<T> conjugate(quaternion<T> const& a)
+{
+  return quaternion<T>(a.w(), -a.x(), -a.y(), -a.z());
+}
+
+template <class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+T dot_product(quaternion<T> const& a, quaternion<T> const& b)
+{
+  return a.w() * b.w() + a.x() * b.x() + a.y() * b.y() + a.z() * b.z();
+}
+
+template <class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+T magnitude(quaternion<T> const& a)
+{
+  return p3a::sqrt(dot_product(a, a));
+}
+
+template <class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+quaternion<T> normalize(quaternion<T> const& a)
+{
+  return a / magnitude(a);
+}
+
+template <class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+quaternion<T> inverse(quaternion<T> const& a)
+{
+  return conjugate(a) / dot_product(a, a);
+}
+
+// rotates v by the unit quaternion q in 15 multiplies,
+// v + w t + u x t with t = 2 u x v, equivalent to q.tensor() * v
+template <class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE constexpr
+vector3<T> rotate(quaternion<T> const& q, vector3<T> const& v)
+{
+  auto const u = q.vector();
+  auto const t = T(2.0) * cross_product(u, v);
+  return v + q.w() * t + cross_product(u, t);
+}
+
+// normalized linear interpolation along the shorter arc
+template <class T, class B>
+[[nodiscard]] P3A_HOST_DEVICE inline
+quaternion<T> nlerp(quaternion<T> const& a, quaternion<T> const& b, B const& t)
+{
+  auto const is_opposite = (dot_product(a, b) < T(0.0));
+  auto const c = condition(is_opposite, -b, b);
+  return normalize(a + (c - a) * t);
+}
+
+// spherical linear interpolation along the shorter arc, which falls back
+// to nlerp where the two rotations are too close for sin(angle) to be divided by
+template <class T, class B>
+[[nodiscard]] P3A_HOST_DEVICE inline
+quaternion<T> slerp(quaternion<T> const& a, quaternion<T> const& b, B const& t)
+{
+  auto const d = dot_product(a, b);
+  auto const is_opposite = (d < T(0.0));
+  auto const c = condition(is_opposite, -b, b);
+  auto const cos_angle = min(condition(is_opposite, -d, d), T(1.0));
+  auto const angle = p3a::acos(cos_angle);
+  auto const sin_angle = p3a::sin(angle);
+  auto const is_close = (sin_angle <= p3a::sqrt(epsilon_value<scalar_type_t<T>>()));
+  auto const safe_sin_angle = condition(is_close, T(1.0), sin_angle);
+  auto const wa = p3a::sin((T(1.0) - t) * angle) / safe_sin_angle;
+  auto const wc = p3a::sin(t * angle) / safe_sin_angle;
+  return condition(is_close, nlerp(a, c, t), a * wa + c * wc);
+}
+
+template <class T>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+quaternion<T> load_quaternion(
+    T const* ptr,
+    int stride,
+    int offset)
+{
+  return quaternion<T>(
+      load(ptr, 0 * stride + offset),
+      load(ptr, 1 * stride + offset),
+      load(ptr, 2 * stride + offset),
+      load(ptr, 3 * stride + offset));
+}
+
+template <class T, class U, class Abi>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+auto load_quaternion(
+    T const* ptr, int stride, int offset, simd_mask<U, Abi> const& mask)
+{
+  auto const w = load(ptr + 0 * stride, offset, mask);
+  auto const x = load(ptr + 1 * stride, offset, mask);
+  auto const y = load(ptr + 2 * stride, offset, mask);
+  auto const z = load(ptr + 3 * stride, offset, mask);
+  using component_type = std::remove_const_t<decltype(w)>;
+  return quaternion<component_type>(w, x, y, z);
+}
+
+template <class T>
+P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+void store(
+    quaternion<T> const& q,
+    T* ptr,
+    int stride,
+    int offset)
+{
+  store(q.w(), ptr + 0 * stride, offset);
+  store(q.x(), ptr + 1 * stride, offset);
+  store(q.y(), ptr + 2 * stride, offset);
+  store(q.z(), ptr + 3 * stride, offset);
+}
+
+template <class T, class U, class V, class Abi>
+P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+void store(
+    quaternion<T> const& q,
+    U* ptr,
+    int stride,
+    int offset,
+    simd_mask<V, Abi> const& mask)
+{
+  store(q.w(), ptr + 0 * stride, offset, mask);
+  store(q.x(), ptr + 1 * stride, offset, mask);
+  store(q.y(), ptr + 2 * stride, offset, mask);
+  store(q.z(), ptr + 3 * stride, offset, mask);
+}
+
+template <class T, class Mask>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
+std::enable_if_t<!std::is_same_v<Mask, bool>, quaternion<T>>
+condition(
+    Mask const& a,
+    quaternion<T> const& b,
+    quaternion<T> const& c)
+{
+  return quaternion<T>(
+      condition(a, b.w(), c.w()),
+      condition(a, b.x(), c.x()),
+      condition(a, b.y(), c.y()),
+      condition(a, b.z(), c.z()));
+}
+
+// rotates count vectors stored in structure-of-arrays layout, component k
+// of vector i being v[k * count + i], by the quaternions q stored the same
+// way with w first, one vector per SIMD lane. result may alias v.
+template <class T, class ExecutionPolicy>
+P3A_NEVER_INLINE
+void batched_rotate(
+    ExecutionPolicy policy,
+    int count,
+    T const* q,
+    T const* v,
+    T* result)
+{
+  using abi_type = typename ExecutionPolicy::simd_abi_type;
+  using mask_type = simd_mask<T, abi_type>;
+  simd_for_each<T>(policy,
+      counting_iterator<int>(0),
+      counting_iterator<int>(count),
+  [=] P3A_HOST_DEVICE (int i, mask_type const& mask) P3A_ALWAYS_INLINE {
+    auto const q_i = load_quaternion(q, count, i, mask);
+    auto const v_i = load_vector3(v, count, i, mask);
+    store(rotate(q_i, v_i), result, count, i, mask);
+  });
+}
+
+// composes count pairs of rotations in structure-of-arrays layout,
+// result[i] = a[i] * b[i], so that b[i] is applied first
+template <class T, class ExecutionPolicy>
+P3A_NEVER_INLINE
+void batched_compose(
+    ExecutionPolicy policy,
+    int count,
+    T const* a,
+    T const* b,
+    T* result)
+{
+  using abi_type = typename ExecutionPolicy::simd_abi_type;
+  using mask_type = simd_mask<T, abi_type>;
+  simd_for_each<T>(policy,
+      counting_iterator<int>(0),
+      counting_iterator<int>(count),
+  [=] P3A_HOST_DEVICE (int i, mask_type const& mask) P3A_ALWAYS_INLINE {
+    auto const a_i = load_quaternion(a, count, i, mask);
+    auto const b_i = load_quaternion(b, count, i, mask);
+    store(a_i * b_i, result, count, i, mask);
+  });
+}
+
+}
@@ -29,9 +29,18 @@ struct is_scalar<double> {
   inline static constexpr bool value = true;
 };
 
+// the underlying arithmetic type, which differs from T only for SIMD types
+template <class T>
+struct scalar_type {
+  using type = T;
+};
+
 }
 
 template <class T>
 inline constexpr bool is_scalar = details::is_scalar<T>::value;
 
+template <class T>
+using scalar_type_t = typename details::scalar_type<T>::type;
+
 }
@@ -19,12 +19,39 @@ using Kokkos::Experimental::native_simd;
 using Kokkos::Experimental::native_simd_mask;
 using Kokkos::Experimental::condition;
 using Kokkos::Experimental::where;
+using Kokkos::Experimental::all_of;
+using Kokkos::Experimental::any_of;
+using Kokkos::Experimental::none_of;
 
 template <class T>
 using device_simd = Kokkos::Experimental::native_simd<T>;
 template <class T>
 using device_simd_mask = Kokkos::Experimental::native_simd_mask<T>;
 
+// bit_cast between SIMD types of equal lane width, one lane at a time;
+// the generic bit_cast would memcpy whole simd objects, which are not
+// trivially copyable classes in every Kokkos backend
+template <class To, class T, class Abi>
+[[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST P3A_DEVICE inline
+To bit_cast(simd<T, Abi> const& src)
+{
+  using to_value_type = typename To::value_type;
+  static_assert(sizeof(to_value_type) == sizeof(T),
+      "bit_cast between SIMD types needs lanes of the same size");
+  static_assert(To::size() == simd<T, Abi>::size(),
+      "bit_cast between SIMD types needs the same number of lanes");
+  int constexpr lane_count = int(simd<T, Abi>::size());
+  T from_lanes[lane_count];
+  to_value_type to_lanes[lane_count];
+  src.copy_to(from_lanes, element_aligned_tag());
+  for (int lane = 0; lane < lane_count; ++lane) {
+    to_lanes[lane] = p3a::bit_cast<to_value_type>(from_lanes[lane]);
+  }
+  To result;
+  result.copy_from(to_lanes, element_aligned_tag());
+  return result;
+}
+
 template <class T, class U, class Abi>
 [[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST P3A_DEVICE inline
 simd<T, Abi> load(T const* ptr, int i, simd_mask<U, Abi> const& mask)
@@ -96,6 +123,18 @@ struct is_scalar<simd<T, Abi>> {
   inline static constexpr bool value = true;
 };
 
+template <class T, class Abi>
+struct scalar_type<simd<T, Abi>> {
+  using type = T;
+};
+
+template <class T, class Abi>
+struct is_math_argument<simd<T, Abi>> {
+  inline static constexpr bool value = true;
+};
+
 }
 
 }
+
+#include "p3a_simd_math.hpp"
@@ -0,0 +1,319 @@
+#pragma once
+
+#include "p3a_static_matrix.hpp"
+#include "p3a_static_vector.hpp"
+#include "p3a_simd.hpp"
+#include "p3a_for_each.hpp"
+#include "p3a_counting_iterator.hpp"
+
+namespace p3a {
+
+/* Direct solvers for small dense systems held in static_matrix.
+   T may be a scalar or a SIMD type, in which case each lane holds an
+   independent system: pivot choices are made per lane and applied with
+   condition(), so there is no branching on data. */
+
+// solves A x = b by Gaussian elimination with partial pivoting,
+// overwriting a with its factors and b with x.
+// returns, per lane, whether a zero pivot was found, in which case
+// that lane's solution is meaningless.
+template <class T, int N>
+[[nodiscard]] P3A_HOST_DEVICE inline
+auto lu_solve(static_matrix<T, N, N>& a, static_vector<T, N>& b)
+{
+  using mask_type = decltype(T() < T());
+  mask_type singular(false);
+  for (int k = 0; k < N; ++k) {
+    T max_magnitude = p3a::abs(a(k, k));
+    T pivot_row = T(k);
+    for (int i = k + 1; i < N; ++i) {
+      T const magnitude = p3a::abs(a(i, k));
+      auto const is_larger = (magnitude > max_magnitude);
+      max_magnitude = condition(is_larger, magnitude, max_magnitude);
+      pivot_row = condition(is_larger, T(i), pivot_row);
+    }
+    for (int i = k + 1; i < N; ++i) {
+      auto const is_pivot = (pivot_row == T(i));
+      if (none_of(is_pivot)) continue;
+      for (int j = k; j < N; ++j) {
+        conditional_swap(is_pivot, a(k, j), a(i, j));
+      }
+      conditional_swap(is_pivot, b[k], b[i]);
+    }
+    auto const is_zero = (max_magnitude == T(0));
+    singular = singular || is_zero;
+    a(k, k) = condition(is_zero, T(1), a(k, k));
+    T const inverse_pivot = T(1) / a(k, k);
+    for (int i = k + 1; i < N; ++i) {
+      T const factor = a(i, k) * inverse_pivot;
+      a(i, k) = factor;
+      for (int j = k + 1; j < N; ++j) {
+        a(i, j) -= factor * a(k, j);
+      }
+      b[i] -= factor * b[k];
+    }
+  }
+  for (int i = N - 1; i >= 0; --i) {
+    T sum = b[i];
+    for (int j = i + 1; j < N; ++j) {
+      sum -= a(i, j) * b[j];
+    }
+    b[i] = sum / a(i, i);
+  }
+  return singular;
+}
+
+// solves A X = B for all M columns of B at once, sharing one factorization,
+// overwriting a with its factors and b with X.
+// returns, per lane, whether a zero pivot was found.
+template <class T, int N, int M>
+[[nodiscard]] P3A_HOST_DEVICE inline
+auto lu_solve(static_matrix<T, N, N>& a, static_matrix<T, N, M>& b)
+{
+  using mask_type = decltype(T() < T());
+  mask_type singular(false);
+  for (int k = 0; k < N; ++k) {
+    T max_magnitude = p3a::abs(a(k, k));
+    T pivot_row = T(k);
+    for (int i = k + 1; i < N; ++i) {
+      T const magnitude = p3a::abs(a(i, k));
+      auto const is_larger = (magnitude > max_magnitude);
+      max_magnitude = condition(is_larger, magnitude, max_magnitude);
+      pivot_row = condition(is_larger, T(i), pivot_row);
+    }
+    for (int i = k + 1; i < N; ++i) {
+      auto const is_pivot = (pivot_row == T(i));
+      if (none_of(is_pivot)) continue;
+      for (int j = k; j < N; ++j) {
+        conditional_swap(is_pivot, a(k, j), a(i, j));
+      }
+      for (int j = 0; j < M; ++j) {
+        conditional_swap(is_pivot, b(k, j), b(i, j));
+      }
+    }
+    auto const is_zero = (max_magnitude == T(0));
+    singular = singular || is_zero;
+    a(k, k) = condition(is_zero, T(1), a(k, k));
+    T const inverse_pivot = T(1) / a(k, k);
+    for (int i = k + 1; i < N; ++i) {
+      T const factor = a(i, k) * inverse_pivot;
+      a(i, k) = factor;
+      for (int j = k + 1; j < N; ++j) {
+        a(i, j) -= factor * a(k, j);
+      }
+      for (int j = 0; j < M; ++j) {
+        b(i, j) -= factor * b(k, j);
+      }
+    }
+  }
+  for (int i = N - 1; i >= 0; --i) {
+    T const inverse_diagonal = T(1) / a(i, i);
+    for (int c = 0; c < M; ++c) {
+      T sum = b(i, c);
+      for (int j = i + 1; j < N; ++j) {
+        sum -= a(i, j) * b(j, c);
+      }
+      b(i, c) = sum * inverse_diagonal;
+    }
+  }
+  return singular;
+}
+
+// solves A x = b for symmetric positive definite A by Cholesky factorization,
+// overwriting the lower triangle of a with L and b with x.
+// returns, per lane, whether A was found not to be positive definite, in which
+// case that lane's solution is meaningless.
+template <class T, int N>
+[[nodiscard]] P3A_HOST_DEVICE inline
+auto cholesky_solve(static_matrix<T, N, N>& a, static_vector<T, N>& b)
+{
+  using mask_type = decltype(T() < T());
+  mask_type not_positive_definite(false);
+  for (int j = 0; j < N; ++j) {
+    T diagonal = a(j, j);
+    for (int k = 0; k < j; ++k) {
+      diagonal -= a(j, k) * a(j, k);
+    }
+    auto const is_bad = !(diagonal > T(0));
+    not_positive_definite = not_positive_definite || is_bad;
+    a(j, j) = p3a::sqrt(condition(is_bad, T(1), diagonal));
+    T const inverse_diagonal = T(1) / a(j, j);
+    for (int i = j + 1; i < N; ++i) {
+      T value = a(i, j);
+      for (int k = 0; k < j; ++k) {
+        value -= a(i, k) * a(j, k);
+      }
+      a(i, j) = value * inverse_diagonal;
+    }
+  }
+  for (int i = 0; i < N; ++i) {
+    T sum = b[i];
+    for (int k = 0; k < i; ++k) {
+      sum -= a(i, k) * b[k];
+    }
+    b[i] = sum / a(i, i);
+  }
+  for (int i = N - 1; i >= 0; --i) {
+    T sum = b[i];
+    for (int k = i + 1; k < N; ++k) {
+      sum -= a(k, i) * b[k];
+    }
+    b[i] = sum / a(i, i);
+  }
+  return not_positive_definite;
+}
+
+// overwrites symmetric positive definite a with its inverse, computed from
+// its Cholesky factor as L^{-T} L^{-1}. only the lower triangle of a is read.
+// returns, per lane, whether A was found not to be positive definite, in which
+// case that lane's result is meaningless.
+template <class T, int N>
+[[nodiscard]] P3A_HOST_DEVICE inline
+auto cholesky_inverse(static_matrix<T, N, N>& a)
+{
+  using mask_type = decltype(T() < T());
+  mask_type not_positive_definite(false);
+  // L, with the reciprocals of its diagonal
+  for (int j = 0; j < N; ++j) {
+    T diagonal = a(j, j);
+    for (int k = 0; k < j; ++k) {
+      diagonal -= a(j, k) * a(j, k);
+    }
+    auto const is_bad = !(diagonal > T(0));
+    not_positive_definite = not_positive_definite || is_bad;
+    a(j, j) = T(1) / p3a::sqrt(condition(is_bad, T(1), diagonal));
+    for (int i = j + 1; i < N; ++i) {
+      T value = a(i, j);
+      for (int k = 0; k < j; ++k) {
+        value -= a(i, k) * a(j, k);
+      }
+      a(i, j) = value * a(j, j);
+    }
+  }
+  // L^{-1} in place of L
+  for (int j = 0; j < N; ++j) {
+    for (int i = j + 1; i < N; ++i) {
+      T sum = T(0);
+      for (int k = j; k < i; ++k) {
+        sum -= a(i, k) * a(k, j);
+      }
+      a(i, j) = sum * a(i, i);
+    }
+  }
+  // A^{-1} = L^{-T} L^{-1}, lower triangle first, then mirrored
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      T sum = T(0);
+      for (int k = i; k < N; ++k) {
+        sum += a(k, i) * a(k, j);
+      }
+      a(i, j) = sum;
+    }
+  }
+  for (int i = 0; i < N; ++i) {
+    for (int j = i + 1; j < N; ++j) {
+      a(i, j) = a(j, i);
+    }
+  }
+  return not_positive_definite;
+}
+
+namespace details {
+
+// systems are stored in structure-of-arrays layout: entry (i, j) of system s is
+// a[(i * N + j) * count + s] and entry i of its right hand side is b[i * count + s].
+// inactive lanes are filled with an identity system so they stay finite.
+template <int N, class T, class Abi>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void load_batched_system(
+    T const* a, T const* b, int count, int s,
+    simd_mask<T, Abi> const& mask,
+    static_matrix<simd<T, Abi>, N, N>& a_s,
+    static_vector<simd<T, Abi>, N>& b_s)
+{
+  using simd_type = simd<T, Abi>;
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      a_s(i, j) = condition(mask,
+          load(a, (i * N + j) * count + s, mask),
+          simd_type(T(i == j)));
+    }
+    b_s[i] = condition(mask, load(b, i * count + s, mask), simd_type(T(0)));
+  }
+}
+
+// failed[s + lane] receives, for each active lane, whether that system failed
+template <class T, class Abi>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void store_batched_failure(
+    simd_mask<T, Abi> const& failure,
+    simd_mask<T, Abi> const& mask,
+    bool* failed,
+    int s)
+{
+  for (int lane = 0; lane < int(simd_mask<T, Abi>::size()); ++lane) {
+    if (mask[lane]) failed[s + lane] = failure[lane];
+  }
+}
+
+template <int N, class T, class Abi>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void store_batched_solution(
+    static_vector<simd<T, Abi>, N> const& x_s,
+    T* x, int count, int s,
+    simd_mask<T, Abi> const& mask)
+{
+  for (int i = 0; i < N; ++i) {
+    store(x_s[i], x, i * count + s, mask);
+  }
+}
+
+}
+
+// solves count independent N x N systems stored in structure-of-arrays layout
+// (see details::load_batched_system), one system per SIMD lane,
+// overwriting b with the solutions.
+// singular[s] tells whether system s had a zero pivot, making its solution meaningless.
+template <int N, class T, class ExecutionPolicy>
+P3A_NEVER_INLINE
+void batched_lu_solve(ExecutionPolicy policy, int count, T const* a, T* b, bool* singular)
+{
+  using abi_type = typename ExecutionPolicy::simd_abi_type;
+  using simd_type = simd<T, abi_type>;
+  using mask_type = simd_mask<T, abi_type>;
+  simd_for_each<T>(policy,
+      counting_iterator<int>(0),
+      counting_iterator<int>(count),
+  [=] P3A_HOST_DEVICE (int s, mask_type const& mask) P3A_ALWAYS_INLINE {
+    static_matrix<simd_type, N, N> a_s;
+    static_vector<simd_type, N> b_s;
+    details::load_batched_system(a, b, count, s, mask, a_s, b_s);
+    auto const failure = lu_solve(a_s, b_s);
+    details::store_batched_solution(b_s, b, count, s, mask);
+    details::store_batched_failure(failure, mask, singular, s);
+  });
+}
+
+// batched_lu_solve for symmetric positive definite systems.
+// not_positive_definite[s] tells whether system s failed, making its solution meaningless.
+template <int N, class T, class ExecutionPolicy>
+P3A_NEVER_INLINE
+void batched_cholesky_solve(ExecutionPolicy policy, int count, T const* a, T* b, bool* not_positive_definite)
+{
+  using abi_type = typename ExecutionPolicy::simd_abi_type;
+  using simd_type = simd<T, abi_type>;
+  using mask_type = simd_mask<T, abi_type>;
+  simd_for_each<T>(policy,
+      counting_iterator<int>(0),
+      counting_iterator<int>(count),
+  [=] P3A_HOST_DEVICE (int s, mask_type const& mask) P3A_ALWAYS_INLINE {
+    static_matrix<simd_type, N, N> a_s;
+    static_vector<simd_type, N> b_s;
+    details::load_batched_system(a, b, count, s, mask, a_s, b_s);
+    auto const failure = cholesky_solve(a_s, b_s);
+    details::store_batched_solution(b_s, b, count, s, mask);
+    details::store_batched_failure(failure, mask, not_positive_definite, s);
+  });
+}
+
+}
@@ -6,6 +6,8 @@
 #include "p3a_diagonal3x3.hpp"
 #include "p3a_static_matrix.hpp"
 #include "p3a_quantity.hpp"
+#include "p3a_for_each.hpp"
+#include "p3a_counting_iterator.hpp"
 
 namespace p3a {
 
@@ -219,4 +221,309 @@ void decompose_singular_values(
   V = static_cast<matrix3x3<T>>(V2);
 }
 
+/* Branch-free 3x3 SVD after McAdams, Selle, Tamstorf, Teran and Sifakis,
+   "Computing the Singular Value Decomposition of 3x3 matrices with minimal
+   branching and elementary floating point operations", 2011.
+   V comes from a fixed number of Jacobi sweeps on A^T A, using approximate
+   Givens rotations accumulated as a quaternion; the columns of A V are then
+   sorted by decreasing norm and a Givens QR factorization of A V gives U
+   and the singular values.
+   Every decision is made with condition(), so T may be a SIMD type and the
+   cost does not depend on the data. */
+
+namespace details {
+
+// rotation diagonalizing [a11, a12; a12, a22] to first order, as the
+// quaternion (ch, sh) of half angles; rotations larger than pi / 4 are
+// replaced by exactly pi / 4, which keeps the sweep convergent
+template <class T>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void approximate_givens_quaternion(
+    T const& a11,
+    T const& a12,
+    T const& a22,
+    T& ch,
+    T& sh)
+{
+  T const gamma = T(5.82842712474619009760); // 3 + 2 sqrt(2)
+  T const cos_pi_8 = T(0.92387953251128675613);
+  T const sin_pi_8 = T(0.38268343236508977173);
+  ch = T(2) * (a11 - a22);
+  sh = a12;
+  auto const is_small_angle = (gamma * square(sh) < square(ch));
+  T const inverse_length = T(1) / p3a::sqrt(
+      condition(is_small_angle, square(ch) + square(sh), T(1)));
+  // an already diagonal block with equal entries would otherwise get
+  // the pi / 8 rotation, which only adds rounding
+  auto const is_diagonal = (a12 == T(0));
+  ch = condition(is_diagonal, T(1), condition(is_small_angle, inverse_length * ch, cos_pi_8));
+  sh = condition(is_diagonal, T(0), condition(is_small_angle, inverse_length * sh, sin_pi_8));
+}
+
+// one Jacobi rotation of the symmetric matrix s in the (0, 1) plane,
+// accumulated into the quaternion q = (x, y, z, w).
+// the rows and columns of s are then permuted cyclically, so calling
+// this three times visits the planes (0, 1), (1, 2) and (2, 0);
+// x, y and z say which quaternion components those planes map to.
+template <int X, int Y, int Z, class T>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void jacobi_conjugation(
+    T& s11,
+    T& s21, T& s22,
+    T& s31, T& s32, T& s33,
+    T* q)
+{
+  T ch, sh;
+  approximate_givens_quaternion(s11, s21, s22, ch, sh);
+  T const scale = square(ch) + square(sh);
+  T const a = (square(ch) - square(sh)) / scale;
+  T const b = (T(2) * sh * ch) / scale;
+  T const old_s11 = s11;
+  T const old_s21 = s21;
+  T const old_s22 = s22;
+  T const old_s31 = s31;
+  T const old_s32 = s32;
+  T const old_s33 = s33;
+  // S = Q^T S Q, stored already permuted for the next plane
+  s11 = -b * (-b * old_s11 + a * old_s21) + a * (-b * old_s21 + a * old_s22);
+  s21 = -b * old_s31 + a * old_s32;
+  s22 = old_s33;
+  s31 = a * (-b * old_s11 + a * old_s21) + b * (-b * old_s21 + a * old_s22);
+  s32 = a * old_s31 + b * old_s32;
+  s33 = a * (a * old_s11 + b * old_s21) + b * (a * old_s21 + b * old_s22);
+  T const tx = q[0] * sh;
+  T const ty = q[1] * sh;
+  T const tz = q[2] * sh;
+  T const t[3] = {tx, ty, tz};
+  T const sw = q[3] * sh;
+  q[0] *= ch;
+  q[1] *= ch;
+  q[2] *= ch;
+  q[3] *= ch;
+  q[Z] += sw;
+  q[3] -= t[Z];
+  q[X] += t[Y];
+  q[Y] -= t[X];
+}
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+matrix3x3<T> quaternion_to_matrix(T const* q)
+{
+  T const x = q[0];
+  T const y = q[1];
+  T const z = q[2];
+  T const w = q[3];
+  return matrix3x3<T>(
+      T(1) - T(2) * (y * y + z * z), T(2) * (x * y - w * z), T(2) * (x * z + w * y),
+      T(2) * (x * y + w * z), T(1) - T(2) * (x * x + z * z), T(2) * (y * z - w * x),
+      T(2) * (x * z - w * y), T(2) * (y * z + w * x), T(1) - T(2) * (x * x + y * y));
+}
+
+// swaps x and y, negating the new y, where mask is true
+template <class Mask, class T>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void conditional_negating_swap(Mask const& mask, T& x, T& y)
+{
+  T const negated_x = -x;
+  x = condition(mask, y, x);
+  y = condition(mask, negated_x, y);
+}
+
+// swaps columns i and j of b and v where mask is true,
+// negating one of them so that v stays a rotation
+template <class Mask, class T>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void conditional_negating_swap_columns(
+    Mask const& mask, int i, int j,
+    matrix3x3<T>& b, matrix3x3<T>& v)
+{
+  for (int k = 0; k < 3; ++k) {
+    conditional_negating_swap(mask, b(k, i), b(k, j));
+    conditional_negating_swap(mask, v(k, i), v(k, j));
+  }
+}
+
+// rounding in the QR step can leave singular values that are equal in exact
+// arithmetic out of order by an ulp. this sorts s by decreasing magnitude,
+// moving the columns of u and v along, and then moves any negative sign to
+// the last singular value, negating two columns of u so it stays a rotation.
+template <class T>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void sort_singular_values(T (&s)[3], matrix3x3<T>& u, matrix3x3<T>& v)
+{
+  for (int i = 0; i < 2; ++i) {
+    for (int j = i + 1; j < 3; ++j) {
+      auto const mask = (p3a::abs(s[i]) < p3a::abs(s[j]));
+      conditional_swap(mask, s[i], s[j]);
+      conditional_negating_swap_columns(mask, i, j, u, v);
+    }
+  }
+  for (int i = 0; i < 2; ++i) {
+    auto const mask = (s[i] < T(0));
+    s[i] = condition(mask, -s[i], s[i]);
+    s[2] = condition(mask, -s[2], s[2]);
+    for (int k = 0; k < 3; ++k) {
+      u(k, i) = condition(mask, -u(k, i), u(k, i));
+      u(k, 2) = condition(mask, -u(k, 2), u(k, 2));
+    }
+  }
+}
+
+// exact Givens rotation zeroing a2 against a1, as the quaternion (ch, sh)
+template <class T>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline
+void qr_givens_quaternion(
+    T const& a1,
+    T const& a2,
+    T& ch,
+    T& sh)
+{
+  // entries are at most about one after scaling, so anything this small
+  // is an exactly zero column as far as the rotation is concerned
+  T const tiny = T(1.0e-30);
+  T const rho = p3a::sqrt(square(a1) + square(a2));
+  sh = condition(rho > tiny, a2, T(0));
+  ch = p3a::abs(a1) + p3a::max(rho, tiny);
+  conditional_swap(a1 < T(0), sh, ch);
+  T const inverse_length = T(1) / p3a::sqrt(square(ch) + square(sh));
+  ch *= inverse_length;
+  sh *= inverse_length;
+}
+
+}
+
+// A = U S V^T with U and V rotations and the singular values in S sorted
+// by decreasing magnitude.
+// because U and V are rotations, the last singular value has the sign of
+// det(A) instead of always being non-negative, which is the form that
+// kinematics wants (the rotation of A is U V^T either way).
+// sweep_count Jacobi sweeps are run. convergence is fast once started,
+// but starting can take a few sweeps for rank-deficient A; the default of
+// eight reaches double precision on random and rank-deficient inputs,
+// where six still leaves relative errors up to about 1e-7.
+template <class T>
+P3A_HOST_DEVICE inline
+void decompose_singular_values_fast(
+    matrix3x3<T> const& A,
+    matrix3x3<T>& U,
+    diagonal3x3<T>& S,
+    matrix3x3<T>& V,
+    int sweep_count = 8)
+{
+  // scaling keeps A^T A from overflowing or underflowing
+  T const max_entry = maximum(
+      maximum(p3a::abs(A.xx()), p3a::abs(A.xy()), p3a::abs(A.xz())),
+      maximum(p3a::abs(A.yx()), p3a::abs(A.yy()), p3a::abs(A.yz())),
+      maximum(p3a::abs(A.zx()), p3a::abs(A.zy()), p3a::abs(A.zz())));
+  T const scale = condition(max_entry == T(0), T(1), max_entry);
+  matrix3x3<T> const a = A / scale;
+  matrix3x3<T> const ata = transpose(a) * a;
+  T s11 = ata.xx();
+  T s21 = ata.yx();
+  T s22 = ata.yy();
+  T s31 = ata.zx();
+  T s32 = ata.zy();
+  T s33 = ata.zz();
+  T q[4] = {T(0), T(0), T(0), T(1)};
+  for (int sweep = 0; sweep < sweep_count; ++sweep) {
+    details::jacobi_conjugation<0, 1, 2>(s11, s21, s22, s31, s32, s33, q);
+    details::jacobi_conjugation<1, 2, 0>(s11, s21, s22, s31, s32, s33, q);
+    details::jacobi_conjugation<2, 0, 1>(s11, s21, s22, s31, s32, s33, q);
+  }
+  T const inverse_length = T(1) / p3a::sqrt(
+      square(q[0]) + square(q[1]) + square(q[2]) + square(q[3]));
+  for (int i = 0; i < 4; ++i) q[i] *= inverse_length;
+  V = details::quaternion_to_matrix(q);
+  matrix3x3<T> b = a * V;
+  // sort the columns of A V by decreasing norm
+  T rho1 = square(b.xx()) + square(b.yx()) + square(b.zx());
+  T rho2 = square(b.xy()) + square(b.yy()) + square(b.zy());
+  T rho3 = square(b.xz()) + square(b.yz()) + square(b.zz());
+  auto mask = (rho1 < rho2);
+  details::conditional_negating_swap_columns(mask, 0, 1, b, V);
+  conditional_swap(mask, rho1, rho2);
+  mask = (rho1 < rho3);
+  details::conditional_negating_swap_columns(mask, 0, 2, b, V);
+  conditional_swap(mask, rho1, rho3);
+  mask = (rho2 < rho3);
+  details::conditional_negating_swap_columns(mask, 1, 2, b, V);
+  // QR factorization of A V by Givens rotations in the (0, 1), (0, 2)
+  // and (1, 2) planes; R is then diagonal up to rounding
+  T ch1, sh1;
+  details::qr_givens_quaternion(b.xx(), b.yx(), ch1, sh1);
+  T a1 = T(1) - T(2) * square(sh1);
+  T b1 = T(2) * ch1 * sh1;
+  matrix3x3<T> r(
+      a1 * b.xx() + b1 * b.yx(), a1 * b.xy() + b1 * b.yy(), a1 * b.xz() + b1 * b.yz(),
+      -b1 * b.xx() + a1 * b.yx(), -b1 * b.xy() + a1 * b.yy(), -b1 * b.xz() + a1 * b.yz(),
+      b.zx(), b.zy(), b.zz());
+  T ch2, sh2;
+  details::qr_givens_quaternion(r.xx(), r.zx(), ch2, sh2);
+  T const a2 = T(1) - T(2) * square(sh2);
+  T const b2 = T(2) * ch2 * sh2;
+  b = matrix3x3<T>(
+      a2 * r.xx() + b2 * r.zx(), a2 * r.xy() + b2 * r.zy(), a2 * r.xz() + b2 * r.zz(),
+      r.yx(), r.yy(), r.yz(),
+      -b2 * r.xx() + a2 * r.zx(), -b2 * r.xy() + a2 * r.zy(), -b2 * r.xz() + a2 * r.zz());
+  T ch3, sh3;
+  details::qr_givens_quaternion(b.yy(), b.zy(), ch3, sh3);
+  T const a3 = T(1) - T(2) * square(sh3);
+  T const b3 = T(2) * ch3 * sh3;
+  T singular_values[3] = {
+      b.xx() * scale,
+      (a3 * b.yy() + b3 * b.zy()) * scale,
+      (-b3 * b.yz() + a3 * b.zz()) * scale};
+  // U = Q1 Q2 Q3 in closed form
+  T const sh1_2 = square(sh1);
+  T const sh2_2 = square(sh2);
+  T const sh3_2 = square(sh3);
+  U = matrix3x3<T>(
+      (T(-1) + T(2) * sh1_2) * (T(-1) + T(2) * sh2_2),
+      T(4) * ch2 * ch3 * (T(-1) + T(2) * sh1_2) * sh2 * sh3 + T(2) * ch1 * sh1 * (T(-1) + T(2) * sh3_2),
+      T(4) * ch1 * ch3 * sh1 * sh3 - T(2) * ch2 * (T(-1) + T(2) * sh1_2) * sh2 * (T(-1) + T(2) * sh3_2),
+      T(2) * ch1 * sh1 * (T(1) - T(2) * sh2_2),
+      T(-8) * ch1 * ch2 * ch3 * sh1 * sh2 * sh3 + (T(-1) + T(2) * sh1_2) * (T(-1) + T(2) * sh3_2),
+      T(-2) * ch3 * sh3 + T(4) * sh1 * (ch3 * sh1 * sh3 + ch1 * ch2 * sh2 * (T(-1) + T(2) * sh3_2)),
+      T(2) * ch2 * sh2,
+      T(2) * ch3 * (T(1) - T(2) * sh2_2) * sh3,
+      (T(-1) + T(2) * sh2_2) * (T(-1) + T(2) * sh3_2));
+  details::sort_singular_values(singular_values, U, V);
+  S = diagonal3x3<T>(singular_values[0], singular_values[1], singular_values[2]);
+}
+
+// decomposes count matrices stored in structure-of-arrays layout, entry (i, j)
+// of matrix s being a[(3 * i + j) * count + s], one matrix per SIMD lane.
+// u and v use the same layout and the singular values of matrix s are
+// s[i * count + s].
+template <class T, class ExecutionPolicy>
+P3A_NEVER_INLINE
+void batched_decompose_singular_values(
+    ExecutionPolicy policy,
+    int count,
+    T const* a,
+    T* u,
+    T* s,
+    T* v,
+    int sweep_count = 8)
+{
+  using abi_type = typename ExecutionPolicy::simd_abi_type;
+  using simd_type = simd<T, abi_type>;
+  using mask_type = simd_mask<T, abi_type>;
+  simd_for_each<T>(policy,
+      counting_iterator<int>(0),
+      counting_iterator<int>(count),
+  [=] P3A_HOST_DEVICE (int i, mask_type const& mask) P3A_ALWAYS_INLINE {
+    matrix3x3<simd_type> const a_i = load_matrix3x3(a, count, i, mask);
+    matrix3x3<simd_type> u_i, v_i;
+    diagonal3x3<simd_type> s_i;
+    decompose_singular_values_fast(a_i, u_i, s_i, v_i, sweep_count);
+    store(u_i, u, count, i, mask);
+    store(v_i, v, count, i, mask);
+    store(s_i.xx(), s, 0 * count + i, mask);
+    store(s_i.yy(), s, 1 * count + i, mask);
+    store(s_i.zz(), s, 2 * count + i, mask);
+  });
+}
+
 }
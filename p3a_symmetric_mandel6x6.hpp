@@ -0,0 +1,788 @@
+#pragma once
+
+#include "p3a_macros.hpp"
+#include "p3a_constants.hpp"
+#include "p3a_symmetric3x3.hpp"
+#include "p3a_mandel6x1.hpp"
+#include "p3a_mandel6x6.hpp"
+#include "p3a_static_matrix.hpp"
+#include "p3a_static_matrix_solve.hpp"
+
+/********************************* NOTES ************************************
+ * This header provides the class:
+ *
+ * - `symmetric_mandel6x6` (6x6) major-symmetric 4th order Tensor
+ *
+ *   Constructors:
+ *
+ *   - `symmetric_mandel6x6(symmetric_mandel6x6)`
+ *   - `symmetric_mandel6x6(<list of 21 upper triangle values>)`
+ *   - `symmetric_mandel6x6(static_matrix<6,6>)` -- reads the upper triangle
+ *
+ * Only the 21 components on and above the diagonal are stored, and there is
+ * no transform flag: as with the other Mandel types the constructors apply
+ * the Mandel transform unless a trailing `false` is given, after which the
+ * stored values are always in Mandel form.
+ * Accessors for components below the diagonal return their mirror image,
+ * so code written against `mandel6x6` accessors works unchanged.
+ *
+ * `inverse` follows the convention of `mandel6x6`: the Voigt form
+ * (`invMandelXform`) is inverted and the result transformed back, so
+ * `full(inverse(C)) == inverse(full(C))`. `inverse_spd` computes the same
+ * by Cholesky factorization when C is positive definite.
+ *
+ * See additional notes in `p3a_mandel6x1.hpp`.
+ */
+
+namespace p3a {
+
+/******************************************************************/
+/******************************************************************/
+template <class T>
+class symmetric_mandel6x6
+/**
+ * Represents a major-symmetric 4th order tensor as the upper triangle
+ * of a 6x6 Mandel array
+ */
+/******************************************************************/
+{
+ T m_x11,m_x12,m_x13,m_x14,m_x15,m_x16,
+   m_x22,m_x23,m_x24,m_x25,m_x26,
+   m_x33,m_x34,m_x35,m_x36,
+   m_x44,m_x45,m_x46,
+   m_x55,m_x56,
+   m_x66;
+
+ public:
+
+  /**** constructors, destructors, and assigns ****/
+  P3A_ALWAYS_INLINE constexpr
+  symmetric_mandel6x6() = default;
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  symmetric_mandel6x6(
+      T const& X11, T const& X12, T const& X13, T const& X14, T const& X15, T const& X16,
+      T const& X22, T const& X23, T const& X24, T const& X25, T const& X26,
+      T const& X33, T const& X34, T const& X35, T const& X36,
+      T const& X44, T const& X45, T const& X46,
+      T const& X55, T const& X56,
+      T const& X66):
+    m_x11(X11),m_x12(X12),m_x13(X13),m_x14(X14),m_x15(X15),m_x16(X16),
+    m_x22(X22),m_x23(X23),m_x24(X24),m_x25(X25),m_x26(X26),
+    m_x33(X33),m_x34(X34),m_x35(X35),m_x36(X36),
+    m_x44(X44),m_x45(X45),m_x46(X46),
+    m_x55(X55),m_x56(X56),
+    m_x66(X66)
+  {
+    this->MandelXform();
+  }
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  symmetric_mandel6x6(
+      T const& X11, T const& X12, T const& X13, T const& X14, T const& X15, T const& X16,
+      T const& X22, T const& X23, T const& X24, T const& X25, T const& X26,
+      T const& X33, T const& X34, T const& X35, T const& X36,
+      T const& X44, T const& X45, T const& X46,
+      T const& X55, T const& X56,
+      T const& X66,
+      bool const& Xform):
+    m_x11(X11),m_x12(X12),m_x13(X13),m_x14(X14),m_x15(X15),m_x16(X16),
+    m_x22(X22),m_x23(X23),m_x24(X24),m_x25(X25),m_x26(X26),
+    m_x33(X33),m_x34(X34),m_x35(X35),m_x36(X36),
+    m_x44(X44),m_x45(X45),m_x46(X46),
+    m_x55(X55),m_x56(X56),
+    m_x66(X66)
+  {
+    if (Xform)
+        this->MandelXform();
+  }
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  symmetric_mandel6x6(
+      static_matrix<T,6,6> const& X):
+    m_x11(X(0,0)),m_x12(X(0,1)),m_x13(X(0,2)),m_x14(X(0,3)),m_x15(X(0,4)),m_x16(X(0,5)),
+    m_x22(X(1,1)),m_x23(X(1,2)),m_x24(X(1,3)),m_x25(X(1,4)),m_x26(X(1,5)),
+    m_x33(X(2,2)),m_x34(X(2,3)),m_x35(X(2,4)),m_x36(X(2,5)),
+    m_x44(X(3,3)),m_x45(X(3,4)),m_x46(X(3,5)),
+    m_x55(X(4,4)),m_x56(X(4,5)),
+    m_x66(X(5,5))
+  {
+    this->MandelXform();
+  }
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  symmetric_mandel6x6(
+      static_matrix<T,6,6> const& X, bool const& Xform):
+    m_x11(X(0,0)),m_x12(X(0,1)),m_x13(X(0,2)),m_x14(X(0,3)),m_x15(X(0,4)),m_x16(X(0,5)),
+    m_x22(X(1,1)),m_x23(X(1,2)),m_x24(X(1,3)),m_x25(X(1,4)),m_x26(X(1,5)),
+    m_x33(X(2,2)),m_x34(X(2,3)),m_x35(X(2,4)),m_x36(X(2,5)),
+    m_x44(X(3,3)),m_x45(X(3,4)),m_x46(X(3,5)),
+    m_x55(X(4,4)),m_x56(X(4,5)),
+    m_x66(X(5,5))
+  {
+    if (Xform)
+        this->MandelXform();
+  }
+
+  //return by mandel index 1-6,1-6; entries below the diagonal mirror those above
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x11() const { return m_x11; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x12() const { return m_x12; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x13() const { return m_x13; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x14() const { return m_x14; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x15() const { return m_x15; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x16() const { return m_x16; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x21() const { return m_x12; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x22() const { return m_x22; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x23() const { return m_x23; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x24() const { return m_x24; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x25() const { return m_x25; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x26() const { return m_x26; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x31() const { return m_x13; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x32() const { return m_x23; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x33() const { return m_x33; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x34() const { return m_x34; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x35() const { return m_x35; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x36() const { return m_x36; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x41() const { return m_x14; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x42() const { return m_x24; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x43() const { return m_x34; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x44() const { return m_x44; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x45() const { return m_x45; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x46() const { return m_x46; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x51() const { return m_x15; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x52() const { return m_x25; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x53() const { return m_x35; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x54() const { return m_x45; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x55() const { return m_x55; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x56() const { return m_x56; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x61() const { return m_x16; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x62() const { return m_x26; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x63() const { return m_x36; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x64() const { return m_x46; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x65() const { return m_x56; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T const& x66() const { return m_x66; }
+
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x11() { return m_x11; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x12() { return m_x12; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x13() { return m_x13; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x14() { return m_x14; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x15() { return m_x15; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x16() { return m_x16; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x21() { return m_x12; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x22() { return m_x22; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x23() { return m_x23; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x24() { return m_x24; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x25() { return m_x25; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x26() { return m_x26; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x31() { return m_x13; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x32() { return m_x23; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x33() { return m_x33; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x34() { return m_x34; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x35() { return m_x35; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x36() { return m_x36; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x41() { return m_x14; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x42() { return m_x24; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x43() { return m_x34; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x44() { return m_x44; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x45() { return m_x45; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x46() { return m_x46; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x51() { return m_x15; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x52() { return m_x25; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x53() { return m_x35; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x54() { return m_x45; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x55() { return m_x55; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x56() { return m_x56; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x61() { return m_x16; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x62() { return m_x26; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x63() { return m_x36; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x64() { return m_x46; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x65() { return m_x56; }
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  T& x66() { return m_x66; }
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  symmetric_mandel6x6<T> zero()
+  {
+    return symmetric_mandel6x6<T>(
+        T(0), T(0), T(0), T(0), T(0), T(0),
+        T(0), T(0), T(0), T(0), T(0),
+        T(0), T(0), T(0), T(0),
+        T(0), T(0), T(0),
+        T(0), T(0),
+        T(0),
+        false);
+  }
+
+  // the identity on symmetric tensors, already in Mandel form
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  symmetric_mandel6x6<T> identity()
+  {
+    return symmetric_mandel6x6<T>(
+        T(1), T(0), T(0), T(0), T(0), T(0),
+        T(1), T(0), T(0), T(0), T(0),
+        T(1), T(0), T(0), T(0),
+        T(1), T(0), T(0),
+        T(1), T(0),
+        T(1),
+        false);
+  }
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  void MandelXform()
+  {
+      T const r2 = square_root_of_two_value<T>();
+      T const two = T(2.0);
+      m_x14*=r2,m_x15*=r2,m_x16*=r2;
+      m_x24*=r2,m_x25*=r2,m_x26*=r2;
+      m_x34*=r2,m_x35*=r2,m_x36*=r2;
+      m_x44*=two,m_x45*=two,m_x46*=two;
+      m_x55*=two,m_x56*=two;
+      m_x66*=two;
+  }
+
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  void invMandelXform()
+  {
+      T const r2 = square_root_of_two_value<T>();
+      T const two = T(2.0);
+      m_x14/=r2,m_x15/=r2,m_x16/=r2;
+      m_x24/=r2,m_x25/=r2,m_x26/=r2;
+      m_x34/=r2,m_x35/=r2,m_x36/=r2;
+      m_x44/=two,m_x45/=two,m_x46/=two;
+      m_x55/=two,m_x56/=two;
+      m_x66/=two;
+  }
+};
+
+/*****************************************************************************
+ * Operator overloads for symmetric_mandel6x6 tensors (4th order tensor)
+ *****************************************************************************/
+//symmetric_mandel6x6 binary operators with scalars
+//multiplication by constant
+template <class A, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+typename std::enable_if<is_scalar<B>, symmetric_mandel6x6<decltype(A() * B())>>::type
+operator*(
+        symmetric_mandel6x6<A> const& a,
+        B const& c)
+{
+    return symmetric_mandel6x6<decltype(a.x11()*c)>(
+            a.x11()*c, a.x12()*c, a.x13()*c, a.x14()*c, a.x15()*c, a.x16()*c,
+            a.x22()*c, a.x23()*c, a.x24()*c, a.x25()*c, a.x26()*c,
+            a.x33()*c, a.x34()*c, a.x35()*c, a.x36()*c,
+            a.x44()*c, a.x45()*c, a.x46()*c,
+            a.x55()*c, a.x56()*c,
+            a.x66()*c,
+            false);
+}
+
+//multiplication by constant
+template <class A, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+typename std::enable_if<is_scalar<A>, symmetric_mandel6x6<decltype(A() * B())>>::type
+operator*(
+        A const& c,
+        symmetric_mandel6x6<B> const& t)
+{
+    return t * c;
+}
+
+//division by constant
+template <class A, class B>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+typename std::enable_if<is_scalar<B>, symmetric_mandel6x6<decltype(A() / B())>>::type
+operator/(
+        symmetric_mandel6x6<A> const& a,
+        B const& c)
+{
+    return symmetric_mandel6x6<decltype(a.x11()/c)>(
+            a.x11()/c, a.x12()/c, a.x13()/c, a.x14()/c, a.x15()/c, a.x16()/c,
+            a.x22()/c, a.x23()/c, a.x24()/c, a.x25()/c, a.x26()/c,
+            a.x33()/c, a.x34()/c, a.x35()/c, a.x36()/c,
+            a.x44()/c, a.x45()/c, a.x46()/c,
+            a.x55()/c, a.x56()/c,
+            a.x66()/c,
+            false);
+}
+
+//multiplication *= by constant
+template <class A>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+void operator*=(
+        symmetric_mandel6x6<A>& a,
+        A const& c)
+{
+    a.x11()*=c;
+    a.x12()*=c;
+    a.x13()*=c;
+    a.x14()*=c;
+    a.x15()*=c;
+    a.x16()*=c;
+    a.x22()*=c;
+    a.x23()*=c;
+    a.x24()*=c;
+    a.x25()*=c;
+    a.x26()*=c;
+    a.x33()*=c;
+    a.x34()*=c;
+    a.x35()*=c;
+    a.x36()*=c;
+    a.x44()*=c;
+    a.x45()*=c;
+    a.x46()*=c;
+    a.x55()*=c;
+    a.x56()*=c;
+    a.x66()*=c;
+}
+
+//division /= by constant
+template <class A>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+void operator/=(
+        symmetric_mandel6x6<A>& a,
+        A const& c)
+{
+    a.x11()/=c;
+    a.x12()/=c;
+    a.x13()/=c;
+    a.x14()/=c;
+    a.x15()/=c;
+    a.x16()/=c;
+    a.x22()/=c;
+    a.x23()/=c;
+    a.x24()/=c;
+    a.x25()/=c;
+    a.x26()/=c;
+    a.x33()/=c;
+    a.x34()/=c;
+    a.x35()/=c;
+    a.x36()/=c;
+    a.x44()/=c;
+    a.x45()/=c;
+    a.x46()/=c;
+    a.x55()/=c;
+    a.x56()/=c;
+    a.x66()/=c;
+}
+
+//addition +=
+template <class A>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+void operator+=(
+        symmetric_mandel6x6<A>& a,
+        symmetric_mandel6x6<A> const& b)
+{
+    a.x11()+=b.x11();
+    a.x12()+=b.x12();
+    a.x13()+=b.x13();
+    a.x14()+=b.x14();
+    a.x15()+=b.x15();
+    a.x16()+=b.x16();
+    a.x22()+=b.x22();
+    a.x23()+=b.x23();
+    a.x24()+=b.x24();
+    a.x25()+=b.x25();
+    a.x26()+=b.x26();
+    a.x33()+=b.x33();
+    a.x34()+=b.x34();
+    a.x35()+=b.x35();
+    a.x36()+=b.x36();
+    a.x44()+=b.x44();
+    a.x45()+=b.x45();
+    a.x46()+=b.x46();
+    a.x55()+=b.x55();
+    a.x56()+=b.x56();
+    a.x66()+=b.x66();
+}
+
+//subtraction -=
+template <class A>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+void operator-=(
+        symmetric_mandel6x6<A>& a,
+        symmetric_mandel6x6<A> const& b)
+{
+    a.x11()-=b.x11();
+    a.x12()-=b.x12();
+    a.x13()-=b.x13();
+    a.x14()-=b.x14();
+    a.x15()-=b.x15();
+    a.x16()-=b.x16();
+    a.x22()-=b.x22();
+    a.x23()-=b.x23();
+    a.x24()-=b.x24();
+    a.x25()-=b.x25();
+    a.x26()-=b.x26();
+    a.x33()-=b.x33();
+    a.x34()-=b.x34();
+    a.x35()-=b.x35();
+    a.x36()-=b.x36();
+    a.x44()-=b.x44();
+    a.x45()-=b.x45();
+    a.x46()-=b.x46();
+    a.x55()-=b.x55();
+    a.x56()-=b.x56();
+    a.x66()-=b.x66();
+}
+
+//addition
+template <class T, class U>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator+(
+        symmetric_mandel6x6<T> const& a,
+        symmetric_mandel6x6<U> const& b)
+{
+  return symmetric_mandel6x6<decltype(a.x11()+b.x11())>(
+    a.x11() + b.x11(), a.x12() + b.x12(), a.x13() + b.x13(), a.x14() + b.x14(), a.x15() + b.x15(), a.x16() + b.x16(),
+    a.x22() + b.x22(), a.x23() + b.x23(), a.x24() + b.x24(), a.x25() + b.x25(), a.x26() + b.x26(),
+    a.x33() + b.x33(), a.x34() + b.x34(), a.x35() + b.x35(), a.x36() + b.x36(),
+    a.x44() + b.x44(), a.x45() + b.x45(), a.x46() + b.x46(),
+    a.x55() + b.x55(), a.x56() + b.x56(),
+    a.x66() + b.x66(),
+    false);
+}
+
+//subtraction
+template <class T, class U>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator-(
+        symmetric_mandel6x6<T> const& a,
+        symmetric_mandel6x6<U> const& b)
+{
+  return symmetric_mandel6x6<decltype(a.x11()-b.x11())>(
+    a.x11() - b.x11(), a.x12() - b.x12(), a.x13() - b.x13(), a.x14() - b.x14(), a.x15() - b.x15(), a.x16() - b.x16(),
+    a.x22() - b.x22(), a.x23() - b.x23(), a.x24() - b.x24(), a.x25() - b.x25(), a.x26() - b.x26(),
+    a.x33() - b.x33(), a.x34() - b.x34(), a.x35() - b.x35(), a.x36() - b.x36(),
+    a.x44() - b.x44(), a.x45() - b.x45(), a.x46() - b.x46(),
+    a.x55() - b.x55(), a.x56() - b.x56(),
+    a.x66() - b.x66(),
+    false);
+}
+
+//negation
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+symmetric_mandel6x6<T> operator-(
+        symmetric_mandel6x6<T> const& a)
+{
+  return symmetric_mandel6x6<T>(
+    -a.x11(), -a.x12(), -a.x13(), -a.x14(), -a.x15(), -a.x16(),
+    -a.x22(), -a.x23(), -a.x24(), -a.x25(), -a.x26(),
+    -a.x33(), -a.x34(), -a.x35(), -a.x36(),
+    -a.x44(), -a.x45(), -a.x46(),
+    -a.x55(), -a.x56(),
+    -a.x66(),
+    false);
+}
+
+/*****************************************************************************
+ * Linear Algebra for symmetric_mandel6x6 (4th order tensor)
+ *****************************************************************************/
+//trace
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+T trace(
+    symmetric_mandel6x6<T> const& a)
+{
+  return a.x11() + a.x22() + a.x33() + a.x44() + a.x55() + a.x66();
+}
+
+//transpose, which is the tensor itself
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+symmetric_mandel6x6<T> transpose(
+    symmetric_mandel6x6<T> const& a)
+{
+  return a;
+}
+
+//the full 36 component form
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+mandel6x6<T> full(
+    symmetric_mandel6x6<T> const& a)
+{
+  return mandel6x6<T>(
+    a.x11(), a.x12(), a.x13(), a.x14(), a.x15(), a.x16(),
+    a.x21(), a.x22(), a.x23(), a.x24(), a.x25(), a.x26(),
+    a.x31(), a.x32(), a.x33(), a.x34(), a.x35(), a.x36(),
+    a.x41(), a.x42(), a.x43(), a.x44(), a.x45(), a.x46(),
+    a.x51(), a.x52(), a.x53(), a.x54(), a.x55(), a.x56(),
+    a.x61(), a.x62(), a.x63(), a.x64(), a.x65(), a.x66(),
+    false);
+}
+
+//the major-symmetric part of a mandel6x6
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+symmetric_mandel6x6<T> symmetric_part(
+    mandel6x6<T> const& a)
+{
+  return symmetric_mandel6x6<T>(
+    a.x11(), T(0.5)*(a.x12() + a.x21()), T(0.5)*(a.x13() + a.x31()), T(0.5)*(a.x14() + a.x41()), T(0.5)*(a.x15() + a.x51()), T(0.5)*(a.x16() + a.x61()),
+    a.x22(), T(0.5)*(a.x23() + a.x32()), T(0.5)*(a.x24() + a.x42()), T(0.5)*(a.x25() + a.x52()), T(0.5)*(a.x26() + a.x62()),
+    a.x33(), T(0.5)*(a.x34() + a.x43()), T(0.5)*(a.x35() + a.x53()), T(0.5)*(a.x36() + a.x63()),
+    a.x44(), T(0.5)*(a.x45() + a.x54()), T(0.5)*(a.x46() + a.x64()),
+    a.x55(), T(0.5)*(a.x56() + a.x65()),
+    a.x66(),
+    false);
+}
+
+namespace details {
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+static_matrix<T, 6, 6> to_static_matrix(
+    symmetric_mandel6x6<T> const& a)
+{
+  static_matrix<T, 6, 6> result;
+  result(0,0) = a.x11();
+  result(0,1) = a.x12();
+  result(0,2) = a.x13();
+  result(0,3) = a.x14();
+  result(0,4) = a.x15();
+  result(0,5) = a.x16();
+  result(1,0) = a.x21();
+  result(1,1) = a.x22();
+  result(1,2) = a.x23();
+  result(1,3) = a.x24();
+  result(1,4) = a.x25();
+  result(1,5) = a.x26();
+  result(2,0) = a.x31();
+  result(2,1) = a.x32();
+  result(2,2) = a.x33();
+  result(2,3) = a.x34();
+  result(2,4) = a.x35();
+  result(2,5) = a.x36();
+  result(3,0) = a.x41();
+  result(3,1) = a.x42();
+  result(3,2) = a.x43();
+  result(3,3) = a.x44();
+  result(3,4) = a.x45();
+  result(3,5) = a.x46();
+  result(4,0) = a.x51();
+  result(4,1) = a.x52();
+  result(4,2) = a.x53();
+  result(4,3) = a.x54();
+  result(4,4) = a.x55();
+  result(4,5) = a.x56();
+  result(5,0) = a.x61();
+  result(5,1) = a.x62();
+  result(5,2) = a.x63();
+  result(5,3) = a.x64();
+  result(5,4) = a.x65();
+  result(5,5) = a.x66();
+  return result;
+}
+
+}
+
+//inverse of a symmetric positive definite tensor by Cholesky factorization,
+//with the same conventions as inverse().
+//there is no pivoting or branching on data, so T may be a SIMD type;
+//the result is meaningless in lanes that are not positive definite.
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE inline
+symmetric_mandel6x6<T> inverse_spd(
+    symmetric_mandel6x6<T> const& a)
+{
+  auto t = a;
+  t.invMandelXform();
+  auto m = details::to_static_matrix(t);
+  (void)cholesky_inverse(m);
+  return symmetric_mandel6x6<T>(m, true);
+}
+
+//inverse of a possibly indefinite tensor, by Gaussian elimination
+//with partial pivoting
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE inline
+symmetric_mandel6x6<T> inverse(
+    symmetric_mandel6x6<T> const& a)
+{
+  auto t = a;
+  t.invMandelXform();
+  auto m = details::to_static_matrix(t);
+  auto x = static_matrix<T, 6, 6>::identity();
+  (void)lu_solve(m, x);
+  return symmetric_part(mandel6x6<T>(x, true));
+}
+
+/** Tensor multiply symmetric_mandel6x6 (6x6) by mandel6x1 (6x1) **/
+template <class T, class U>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator*(
+    symmetric_mandel6x6<T> const &C,
+    mandel6x1<U> const &v)
+{
+    return mandel6x1<decltype(C.x11()*v.x1())>(
+        (C.x11()*v.x1() + C.x12()*v.x2() + C.x13()*v.x3() + C.x14()*v.x4() + C.x15()*v.x5() + C.x16()*v.x6()),
+        (C.x21()*v.x1() + C.x22()*v.x2() + C.x23()*v.x3() + C.x24()*v.x4() + C.x25()*v.x5() + C.x26()*v.x6()),
+        (C.x31()*v.x1() + C.x32()*v.x2() + C.x33()*v.x3() + C.x34()*v.x4() + C.x35()*v.x5() + C.x36()*v.x6()),
+        (C.x41()*v.x1() + C.x42()*v.x2() + C.x43()*v.x3() + C.x44()*v.x4() + C.x45()*v.x5() + C.x46()*v.x6()),
+        (C.x51()*v.x1() + C.x52()*v.x2() + C.x53()*v.x3() + C.x54()*v.x4() + C.x55()*v.x5() + C.x56()*v.x6()),
+        (C.x61()*v.x1() + C.x62()*v.x2() + C.x63()*v.x3() + C.x64()*v.x4() + C.x65()*v.x5() + C.x66()*v.x6()),
+        false); //already transformed
+}
+
+/** Tensor multiply symmetric_mandel6x6 (6x6) by symmetric3x3 (3x3) **/
+template <class T, class U>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator*(
+    symmetric_mandel6x6<T> const &C,
+    symmetric3x3<U> const &s)
+{
+    mandel6x1<U> v(s);
+    return C*v;
+}
+
+/** Tensor multiplication: symmetric_mandel6x6 * symmetric_mandel6x6, which is not symmetric in general **/
+template <class T, class U>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator*(
+    symmetric_mandel6x6<T> const &e,
+    symmetric_mandel6x6<U> const &d)
+{
+    return mandel6x6<decltype(e.x11()*d.x11())>(
+            e.x11()*d.x11() + e.x12()*d.x21() + e.x13()*d.x31() + e.x14()*d.x41() + e.x15()*d.x51() + e.x16()*d.x61(),
+            e.x11()*d.x12() + e.x12()*d.x22() + e.x13()*d.x32() + e.x14()*d.x42() + e.x15()*d.x52() + e.x16()*d.x62(),
+            e.x11()*d.x13() + e.x12()*d.x23() + e.x13()*d.x33() + e.x14()*d.x43() + e.x15()*d.x53() + e.x16()*d.x63(),
+            e.x11()*d.x14() + e.x12()*d.x24() + e.x13()*d.x34() + e.x14()*d.x44() + e.x15()*d.x54() + e.x16()*d.x64(),
+            e.x11()*d.x15() + e.x12()*d.x25() + e.x13()*d.x35() + e.x14()*d.x45() + e.x15()*d.x55() + e.x16()*d.x65(),
+            e.x11()*d.x16() + e.x12()*d.x26() + e.x13()*d.x36() + e.x14()*d.x46() + e.x15()*d.x56() + e.x16()*d.x66(),
+            e.x21()*d.x11() + e.x22()*d.x21() + e.x23()*d.x31() + e.x24()*d.x41() + e.x25()*d.x51() + e.x26()*d.x61(),
+            e.x21()*d.x12() + e.x22()*d.x22() + e.x23()*d.x32() + e.x24()*d.x42() + e.x25()*d.x52() + e.x26()*d.x62(),
+            e.x21()*d.x13() + e.x22()*d.x23() + e.x23()*d.x33() + e.x24()*d.x43() + e.x25()*d.x53() + e.x26()*d.x63(),
+            e.x21()*d.x14() + e.x22()*d.x24() + e.x23()*d.x34() + e.x24()*d.x44() + e.x25()*d.x54() + e.x26()*d.x64(),
+            e.x21()*d.x15() + e.x22()*d.x25() + e.x23()*d.x35() + e.x24()*d.x45() + e.x25()*d.x55() + e.x26()*d.x65(),
+            e.x21()*d.x16() + e.x22()*d.x26() + e.x23()*d.x36() + e.x24()*d.x46() + e.x25()*d.x56() + e.x26()*d.x66(),
+            e.x31()*d.x11() + e.x32()*d.x21() + e.x33()*d.x31() + e.x34()*d.x41() + e.x35()*d.x51() + e.x36()*d.x61(),
+            e.x31()*d.x12() + e.x32()*d.x22() + e.x33()*d.x32() + e.x34()*d.x42() + e.x35()*d.x52() + e.x36()*d.x62(),
+            e.x31()*d.x13() + e.x32()*d.x23() + e.x33()*d.x33() + e.x34()*d.x43() + e.x35()*d.x53() + e.x36()*d.x63(),
+            e.x31()*d.x14() + e.x32()*d.x24() + e.x33()*d.x34() + e.x34()*d.x44() + e.x35()*d.x54() + e.x36()*d.x64(),
+            e.x31()*d.x15() + e.x32()*d.x25() + e.x33()*d.x35() + e.x34()*d.x45() + e.x35()*d.x55() + e.x36()*d.x65(),
+            e.x31()*d.x16() + e.x32()*d.x26() + e.x33()*d.x36() + e.x34()*d.x46() + e.x35()*d.x56() + e.x36()*d.x66(),
+            e.x41()*d.x11() + e.x42()*d.x21() + e.x43()*d.x31() + e.x44()*d.x41() + e.x45()*d.x51() + e.x46()*d.x61(),
+            e.x41()*d.x12() + e.x42()*d.x22() + e.x43()*d.x32() + e.x44()*d.x42() + e.x45()*d.x52() + e.x46()*d.x62(),
+            e.x41()*d.x13() + e.x42()*d.x23() + e.x43()*d.x33() + e.x44()*d.x43() + e.x45()*d.x53() + e.x46()*d.x63(),
+            e.x41()*d.x14() + e.x42()*d.x24() + e.x43()*d.x34() + e.x44()*d.x44() + e.x45()*d.x54() + e.x46()*d.x64(),
+            e.x41()*d.x15() + e.x42()*d.x25() + e.x43()*d.x35() + e.x44()*d.x45() + e.x45()*d.x55() + e.x46()*d.x65(),
+            e.x41()*d.x16() + e.x42()*d.x26() + e.x43()*d.x36() + e.x44()*d.x46() + e.x45()*d.x56() + e.x46()*d.x66(),
+            e.x51()*d.x11() + e.x52()*d.x21() + e.x53()*d.x31() + e.x54()*d.x41() + e.x55()*d.x51() + e.x56()*d.x61(),
+            e.x51()*d.x12() + e.x52()*d.x22() + e.x53()*d.x32() + e.x54()*d.x42() + e.x55()*d.x52() + e.x56()*d.x62(),
+            e.x51()*d.x13() + e.x52()*d.x23() + e.x53()*d.x33() + e.x54()*d.x43() + e.x55()*d.x53() + e.x56()*d.x63(),
+            e.x51()*d.x14() + e.x52()*d.x24() + e.x53()*d.x34() + e.x54()*d.x44() + e.x55()*d.x54() + e.x56()*d.x64(),
+            e.x51()*d.x15() + e.x52()*d.x25() + e.x53()*d.x35() + e.x54()*d.x45() + e.x55()*d.x55() + e.x56()*d.x65(),
+            e.x51()*d.x16() + e.x52()*d.x26() + e.x53()*d.x36() + e.x54()*d.x46() + e.x55()*d.x56() + e.x56()*d.x66(),
+            e.x61()*d.x11() + e.x62()*d.x21() + e.x63()*d.x31() + e.x64()*d.x41() + e.x65()*d.x51() + e.x66()*d.x61(),
+            e.x61()*d.x12() + e.x62()*d.x22() + e.x63()*d.x32() + e.x64()*d.x42() + e.x65()*d.x52() + e.x66()*d.x62(),
+            e.x61()*d.x13() + e.x62()*d.x23() + e.x63()*d.x33() + e.x64()*d.x43() + e.x65()*d.x53() + e.x66()*d.x63(),
+            e.x61()*d.x14() + e.x62()*d.x24() + e.x63()*d.x34() + e.x64()*d.x44() + e.x65()*d.x54() + e.x66()*d.x64(),
+            e.x61()*d.x15() + e.x62()*d.x25() + e.x63()*d.x35() + e.x64()*d.x45() + e.x65()*d.x55() + e.x66()*d.x65(),
+            e.x61()*d.x16() + e.x62()*d.x26() + e.x63()*d.x36() + e.x64()*d.x46() + e.x65()*d.x56() + e.x66()*d.x66(),
+            false);//already transformed
+}
+
+/** Tensor multiplication: mandel6x6 * symmetric_mandel6x6 **/
+template <class T, class U>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator*(
+    mandel6x6<T> const &e,
+    symmetric_mandel6x6<U> const &d)
+{
+    return e * full(d);
+}
+
+/** Tensor multiplication: symmetric_mandel6x6 * mandel6x6 **/
+template <class T, class U>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto operator*(
+    symmetric_mandel6x6<T> const &e,
+    mandel6x6<U> const &d)
+{
+    return full(e) * d;
+}
+
+//misc
+inline int constexpr symmetric_mandel6x6_component_count = 21;
+
+//output print
+template <class U>
+P3A_ALWAYS_INLINE constexpr
+std::ostream& operator<<(std::ostream& os, symmetric_mandel6x6<U> const& a)
+{
+  return os << full(a);
+}
+
+}
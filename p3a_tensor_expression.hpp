@@ -0,0 +1,435 @@
+#pragma once
+
+#include <type_traits>
+
+#include "p3a_macros.hpp"
+#include "p3a_scalar.hpp"
+#include "p3a_identity3x3.hpp"
+#include "p3a_symmetric3x3.hpp"
+#include "p3a_matrix3x3.hpp"
+#include "p3a_mandel6x6.hpp"
+
+namespace p3a {
+
+/* Opt-in expression templates for element-wise tensor arithmetic.
+   Wrapping any operand in lazy() makes +, -, unary -, and multiplication
+   or division by a scalar build a small expression object instead of a
+   tensor, and evaluate() then computes each component of the result in a
+   single pass, so a chain such as
+
+     evaluate((lazy(E) * scale - identity3x3) * T(0.5))
+
+   needs no intermediate tensors at all. Operands may be matrix3x3,
+   symmetric3x3, mandel6x6, identity3x3 or other expressions; the result is
+   a symmetric3x3 only if every operand is symmetric, and symmetric results
+   only evaluate their 6 unique components.
+   Matrix products are not element-wise and are left to the eager operators.
+   Expressions refer to their operands, so they must be evaluated within the
+   full expression that creates them, like any expression template. */
+
+namespace details {
+
+// ordered so that combining two shapes yields the larger one
+enum class lazy_shape {
+  identity3x3,
+  symmetric3x3,
+  matrix3x3,
+  mandel6x6,
+};
+
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+lazy_shape combine_lazy_shapes(lazy_shape a, lazy_shape b)
+{
+  return (a < b) ? b : a;
+}
+
+// void is the value type of identity3x3, which adapts to the other operand
+template <class A, class B>
+struct lazy_common_value {
+  using type = decltype(std::declval<A>() + std::declval<B>());
+};
+
+template <class A>
+struct lazy_common_value<A, void> {
+  using type = A;
+};
+
+template <class B>
+struct lazy_common_value<void, B> {
+  using type = B;
+};
+
+template <class Tensor>
+struct lazy_traits {
+  inline static constexpr bool is_operand = false;
+};
+
+template <class T>
+struct lazy_traits<matrix3x3<T>> {
+  inline static constexpr bool is_operand = true;
+  inline static constexpr lazy_shape shape = lazy_shape::matrix3x3;
+  using value_type = T;
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  T const& component(matrix3x3<T> const& a, int i, int j)
+  {
+    return a(i, j);
+  }
+};
+
+template <class T>
+struct lazy_traits<symmetric3x3<T>> {
+  inline static constexpr bool is_operand = true;
+  inline static constexpr lazy_shape shape = lazy_shape::symmetric3x3;
+  using value_type = T;
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  T const& component(symmetric3x3<T> const& a, int i, int j)
+  {
+    return a(i, j);
+  }
+};
+
+template <class T>
+struct lazy_traits<mandel6x6<T>> {
+  inline static constexpr bool is_operand = true;
+  inline static constexpr lazy_shape shape = lazy_shape::mandel6x6;
+  using value_type = T;
+  // indices are compile-time constants after inlining, so the switch folds away
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  T const& component(mandel6x6<T> const& a, int i, int j)
+  {
+    switch (6 * i + j) {
+      case 0: return a.x11();
+      case 1: return a.x12();
+      case 2: return a.x13();
+      case 3: return a.x14();
+      case 4: return a.x15();
+      case 5: return a.x16();
+      case 6: return a.x21();
+      case 7: return a.x22();
+      case 8: return a.x23();
+      case 9: return a.x24();
+      case 10: return a.x25();
+      case 11: return a.x26();
+      case 12: return a.x31();
+      case 13: return a.x32();
+      case 14: return a.x33();
+      case 15: return a.x34();
+      case 16: return a.x35();
+      case 17: return a.x36();
+      case 18: return a.x41();
+      case 19: return a.x42();
+      case 20: return a.x43();
+      case 21: return a.x44();
+      case 22: return a.x45();
+      case 23: return a.x46();
+      case 24: return a.x51();
+      case 25: return a.x52();
+      case 26: return a.x53();
+      case 27: return a.x54();
+      case 28: return a.x55();
+      case 29: return a.x56();
+      case 30: return a.x61();
+      case 31: return a.x62();
+      case 32: return a.x63();
+      case 33: return a.x64();
+      case 34: return a.x65();
+      default: return a.x66();
+    }
+  }
+};
+
+template <>
+struct lazy_traits<identity3x3_type> {
+  inline static constexpr bool is_operand = true;
+  inline static constexpr lazy_shape shape = lazy_shape::identity3x3;
+  using value_type = void;
+};
+
+struct lazy_plus {
+  template <class A, class B>
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  auto apply(A const& a, B const& b) { return a + b; }
+};
+
+struct lazy_minus {
+  template <class A, class B>
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  auto apply(A const& a, B const& b) { return a - b; }
+};
+
+struct lazy_multiplies {
+  template <class A, class B>
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  auto apply(A const& a, B const& b) { return a * b; }
+};
+
+struct lazy_divides {
+  template <class A, class B>
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE static constexpr
+  auto apply(A const& a, B const& b) { return a / b; }
+};
+
+}
+
+// a reference to a tensor taking part in an expression
+template <class Tensor>
+class lazy_tensor {
+  Tensor const& m_tensor;
+ public:
+  using traits_type = details::lazy_traits<Tensor>;
+  using value_type = typename traits_type::value_type;
+  inline static constexpr details::lazy_shape shape = traits_type::shape;
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr explicit
+  lazy_tensor(Tensor const& tensor_arg)
+    :m_tensor(tensor_arg)
+  {}
+  template <class V>
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  decltype(auto) component(int i, int j) const
+  {
+    if constexpr (shape == details::lazy_shape::identity3x3) {
+      return V(i == j ? 1 : 0);
+    } else {
+      return traits_type::component(m_tensor, i, j);
+    }
+  }
+};
+
+// element-wise combination of two expressions
+template <class Left, class Right, class Op>
+class lazy_binary {
+  Left m_left;
+  Right m_right;
+ public:
+  using value_type = typename details::lazy_common_value<
+    typename Left::value_type, typename Right::value_type>::type;
+  inline static constexpr details::lazy_shape shape =
+    details::combine_lazy_shapes(Left::shape, Right::shape);
+  static_assert(
+      (Left::shape == details::lazy_shape::mandel6x6) ==
+      (Right::shape == details::lazy_shape::mandel6x6),
+      "lazy tensor expressions cannot mix 6x6 and 3x3 operands");
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  lazy_binary(Left const& left_arg, Right const& right_arg)
+    :m_left(left_arg)
+    ,m_right(right_arg)
+  {}
+  template <class V>
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  auto component(int i, int j) const
+  {
+    return Op::apply(
+        m_left.template component<V>(i, j),
+        m_right.template component<V>(i, j));
+  }
+};
+
+// an expression multiplied or divided by a scalar
+template <class Expression, class Scalar, class Op>
+class lazy_scaled {
+  Expression m_expression;
+  Scalar m_scalar;
+ public:
+  using value_type = decltype(Op::apply(
+        std::declval<typename Expression::value_type>(), std::declval<Scalar>()));
+  inline static constexpr details::lazy_shape shape = Expression::shape;
+  static_assert(shape != details::lazy_shape::identity3x3,
+      "scale identity3x3 eagerly with scaled_identity3x3");
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  lazy_scaled(Expression const& expression_arg, Scalar const& scalar_arg)
+    :m_expression(expression_arg)
+    ,m_scalar(scalar_arg)
+  {}
+  template <class V>
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  auto component(int i, int j) const
+  {
+    return Op::apply(m_expression.template component<V>(i, j), m_scalar);
+  }
+};
+
+template <class Expression>
+class lazy_negation {
+  Expression m_expression;
+ public:
+  using value_type = typename Expression::value_type;
+  inline static constexpr details::lazy_shape shape = Expression::shape;
+  P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr explicit
+  lazy_negation(Expression const& expression_arg)
+    :m_expression(expression_arg)
+  {}
+  template <class V>
+  [[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+  auto component(int i, int j) const
+  {
+    return -m_expression.template component<V>(i, j);
+  }
+};
+
+namespace details {
+
+template <class T>
+struct is_lazy_expression {
+  inline static constexpr bool value = false;
+};
+
+template <class Tensor>
+struct is_lazy_expression<lazy_tensor<Tensor>> {
+  inline static constexpr bool value = true;
+};
+
+template <class Left, class Right, class Op>
+struct is_lazy_expression<lazy_binary<Left, Right, Op>> {
+  inline static constexpr bool value = true;
+};
+
+template <class Expression, class Scalar, class Op>
+struct is_lazy_expression<lazy_scaled<Expression, Scalar, Op>> {
+  inline static constexpr bool value = true;
+};
+
+template <class Expression>
+struct is_lazy_expression<lazy_negation<Expression>> {
+  inline static constexpr bool value = true;
+};
+
+template <class T>
+inline constexpr bool is_lazy_expression_v = is_lazy_expression<T>::value;
+
+template <class T>
+inline constexpr bool is_lazy_operand_v =
+  is_lazy_expression_v<T> || lazy_traits<T>::is_operand;
+
+// operators are only enabled when at least one side is already lazy,
+// so eager code never changes meaning
+template <class Left, class Right>
+inline constexpr bool is_lazy_pair_v =
+  (is_lazy_expression_v<Left> && is_lazy_operand_v<Right>) ||
+  (is_lazy_operand_v<Left> && is_lazy_expression_v<Right>);
+
+template <class T>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+auto as_lazy(T const& a)
+{
+  if constexpr (is_lazy_expression_v<T>) {
+    return a;
+  } else {
+    return lazy_tensor<T>(a);
+  }
+}
+
+template <class T>
+using as_lazy_t = decltype(as_lazy(std::declval<T const&>()));
+
+// only names the result type once the operands are known to be lazy, so that
+// overload resolution for unrelated operator+ and operator- stays quiet
+template <bool IsLazyPair, class Left, class Right, class Op>
+struct lazy_binary_result {
+};
+
+template <class Left, class Right, class Op>
+struct lazy_binary_result<true, Left, Right, Op> {
+  using type = lazy_binary<as_lazy_t<Left>, as_lazy_t<Right>, Op>;
+};
+
+template <class Left, class Right, class Op>
+using lazy_binary_result_t = typename lazy_binary_result<
+  is_lazy_pair_v<Left, Right>, Left, Right, Op>::type;
+
+}
+
+template <class Tensor>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+std::enable_if_t<details::lazy_traits<Tensor>::is_operand, lazy_tensor<Tensor>>
+lazy(Tensor const& a)
+{
+  return lazy_tensor<Tensor>(a);
+}
+
+template <class Left, class Right>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+details::lazy_binary_result_t<Left, Right, details::lazy_plus>
+operator+(Left const& left, Right const& right)
+{
+  return {details::as_lazy(left), details::as_lazy(right)};
+}
+
+template <class Left, class Right>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+details::lazy_binary_result_t<Left, Right, details::lazy_minus>
+operator-(Left const& left, Right const& right)
+{
+  return {details::as_lazy(left), details::as_lazy(right)};
+}
+
+template <class Expression>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+std::enable_if_t<details::is_lazy_expression_v<Expression>, lazy_negation<Expression>>
+operator-(Expression const& expression)
+{
+  return lazy_negation<Expression>(expression);
+}
+
+template <class Expression, class Scalar>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+std::enable_if_t<details::is_lazy_expression_v<Expression> && is_scalar<Scalar>,
+  lazy_scaled<Expression, Scalar, details::lazy_multiplies>>
+operator*(Expression const& expression, Scalar const& scalar)
+{
+  return {expression, scalar};
+}
+
+template <class Scalar, class Expression>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+std::enable_if_t<details::is_lazy_expression_v<Expression> && is_scalar<Scalar>,
+  lazy_scaled<Expression, Scalar, details::lazy_multiplies>>
+operator*(Scalar const& scalar, Expression const& expression)
+{
+  return {expression, scalar};
+}
+
+template <class Expression, class Scalar>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+std::enable_if_t<details::is_lazy_expression_v<Expression> && is_scalar<Scalar>,
+  lazy_scaled<Expression, Scalar, details::lazy_divides>>
+operator/(Expression const& expression, Scalar const& scalar)
+{
+  return {expression, scalar};
+}
+
+// computes every component of an expression in a single pass
+template <class Expression>
+[[nodiscard]] P3A_HOST_DEVICE P3A_ALWAYS_INLINE constexpr
+std::enable_if_t<details::is_lazy_expression_v<Expression>,
+  typename std::conditional_t<Expression::shape == details::lazy_shape::mandel6x6,
+    mandel6x6<typename Expression::value_type>,
+    std::conditional_t<Expression::shape == details::lazy_shape::matrix3x3,
+      matrix3x3<typename Expression::value_type>,
+      symmetric3x3<typename Expression::value_type>>>>
+evaluate(Expression const& e)
+{
+  using V = typename Expression::value_type;
+  static_assert(!std::is_void_v<V>, "cannot evaluate identity3x3 alone");
+  if constexpr (Expression::shape == details::lazy_shape::mandel6x6) {
+    return mandel6x6<V>(
+        e.template component<V>(0,0), e.template component<V>(0,1), e.template component<V>(0,2), e.template component<V>(0,3), e.template component<V>(0,4), e.template component<V>(0,5),
+        e.template component<V>(1,0), e.template component<V>(1,1), e.template component<V>(1,2), e.template component<V>(1,3), e.template component<V>(1,4), e.template component<V>(1,5),
+        e.template component<V>(2,0), e.template component<V>(2,1), e.template component<V>(2,2), e.template component<V>(2,3), e.template component<V>(2,4), e.template component<V>(2,5),
+        e.template component<V>(3,0), e.template component<V>(3,1), e.template component<V>(3,2), e.template component<V>(3,3), e.template component<V>(3,4), e.template component<V>(3,5),
+        e.template component<V>(4,0), e.template component<V>(4,1), e.template component<V>(4,2), e.template component<V>(4,3), e.template component<V>(4,4), e.template component<V>(4,5),
+        e.template component<V>(5,0), e.template component<V>(5,1), e.template component<V>(5,2), e.template component<V>(5,3), e.template component<V>(5,4), e.template component<V>(5,5),
+        false);
+  } else if constexpr (Expression::shape == details::lazy_shape::matrix3x3) {
+    return matrix3x3<V>(
+        e.template component<V>(0, 0), e.template component<V>(0, 1), e.template component<V>(0, 2),
+        e.template component<V>(1, 0), e.template component<V>(1, 1), e.template component<V>(1, 2),
+        e.template component<V>(2, 0), e.template component<V>(2, 1), e.template component<V>(2, 2));
+  } else {
+    return symmetric3x3<V>(
+        e.template component<V>(0, 0), e.template component<V>(0, 1), e.template component<V>(0, 2),
+        e.template component<V>(1, 1), e.template component<V>(1, 2),
+        e.template component<V>(2, 2));
+  }
+}
+
+}
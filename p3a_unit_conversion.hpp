@@ -0,0 +1,191 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "p3a_quantity.hpp"
+#include "p3a_for_each.hpp"
+
+namespace p3a {
+
+/* Bulk unit conversion.
+
+   Converting a field between units is one multiply and one add per value
+   once kul::conversion<T> has reduced the pair of units to a multiplier and
+   an offset. These functions compute that conversion once, outside the loop,
+   and sweep it over the range with for_each or simd_for_each, so the cost at
+   an I/O boundary is bounded by memory bandwidth. When both units are
+   compile-time types the conversion is a constant expression and the sweep
+   sees literal coefficients.
+
+   Mixing units of different physical dimension, or an absolute unit such
+   as kelvin with a relative one, is a compile error for compile-time units
+   and throws std::runtime_error for runtime ones, like the other errors
+   of kul's runtime units. */
+
+namespace details {
+
+template <class T, class From, class To>
+P3A_HOST_DEVICE P3A_ALWAYS_INLINE inline constexpr
+kul::conversion<T> static_unit_conversion()
+{
+  static_assert(From::static_dimension() == To::static_dimension(),
+      "cannot convert between units with different dimensions");
+  static_assert(kul::is_absolute<From> == kul::is_absolute<To>,
+      "cannot convert from absolute to relative or vice-versa");
+  return kul::static_conversion<T, From, To>();
+}
+
+template <class Unit>
+inline constexpr bool is_static_unit_v = std::is_base_of_v<kul::named, Unit>;
+
+template <class T, class From, class To,
+    std::enable_if_t<is_static_unit_v<From> && is_static_unit_v<To>, bool> = false>
+constexpr kul::conversion<T> unit_conversion(From const&, To const&)
+{
+  return static_unit_conversion<T, From, To>();
+}
+
+inline kul::interned_unit const& runtime_unit(kul::interned_unit const& u)
+{
+  return u;
+}
+
+inline kul::interned_unit runtime_unit(kul::unit const& u)
+{
+  return kul::interned_unit(u);
+}
+
+template <class T, class From, class To,
+    std::enable_if_t<!(is_static_unit_v<From> && is_static_unit_v<To>), bool> = false>
+kul::conversion<T> unit_conversion(From const& from, To const& to)
+{
+  auto const& runtime_from = runtime_unit(from);
+  auto const& runtime_to = runtime_unit(to);
+  if (runtime_from.dimension() != runtime_to.dimension()) {
+    throw std::runtime_error("cannot convert " + runtime_from.name() + " to " +
+        runtime_to.name() + ", which has a different physical dimension");
+  }
+  if (runtime_from.origin().has_value() != runtime_to.origin().has_value()) {
+    throw std::runtime_error("cannot convert " + runtime_from.name() + " to " +
+        runtime_to.name() + ": one is absolute and the other relative");
+  }
+  return kul::conversion<T>(runtime_from, runtime_to);
+}
+
+}
+
+template <class ExecutionPolicy, class T>
+P3A_NEVER_INLINE void convert(
+    ExecutionPolicy policy,
+    T const* first,
+    T const* last,
+    T* d_first,
+    kul::conversion<T> const& c)
+{
+  for_each(policy,
+      counting_iterator<int>(0),
+      counting_iterator<int>(int(last - first)),
+  [=] P3A_HOST_DEVICE (int i) P3A_ALWAYS_INLINE {
+    d_first[i] = c(first[i]);
+  });
+}
+
+template <class ExecutionPolicy, class T>
+P3A_NEVER_INLINE void simd_convert(
+    ExecutionPolicy policy,
+    T const* first,
+    T const* last,
+    T* d_first,
+    kul::conversion<T> const& c)
+{
+  using simd_abi_type = typename ExecutionPolicy::simd_abi_type;
+  using simd_type = simd<T, simd_abi_type>;
+  using mask_type = simd_mask<T, simd_abi_type>;
+  simd_type const multiplier(c.multiplier());
+  simd_type const offset(c.offset());
+  simd_for_each<T>(policy,
+      counting_iterator<int>(0),
+      counting_iterator<int>(int(last - first)),
+  [=] P3A_HOST_DEVICE (int i, mask_type const& mask) P3A_ALWAYS_INLINE {
+    simd_type const value = load(first, i, mask);
+    store(simd_type(value * multiplier + offset), d_first, i, mask);
+  });
+}
+
+template <class ExecutionPolicy, class T, class From, class To>
+void convert(
+    ExecutionPolicy policy,
+    T const* first,
+    T const* last,
+    T* d_first,
+    From const& from,
+    To const& to)
+{
+  convert(policy, first, last, d_first, details::unit_conversion<T>(from, to));
+}
+
+template <class ExecutionPolicy, class T, class From, class To>
+void simd_convert(
+    ExecutionPolicy policy,
+    T const* first,
+    T const* last,
+    T* d_first,
+    From const& from,
+    To const& to)
+{
+  simd_convert(policy, first, last, d_first, details::unit_conversion<T>(from, to));
+}
+
+template <class ExecutionPolicy, class T, class From, class To>
+void convert_in_place(
+    ExecutionPolicy policy,
+    T* first,
+    T* last,
+    From const& from,
+    To const& to)
+{
+  convert(policy, first, last, first, details::unit_conversion<T>(from, to));
+}
+
+template <class ExecutionPolicy, class T, class From, class To>
+void simd_convert_in_place(
+    ExecutionPolicy policy,
+    T* first,
+    T* last,
+    From const& from,
+    To const& to)
+{
+  simd_convert(policy, first, last, first, details::unit_conversion<T>(from, to));
+}
+
+// arrays of compile-time quantities carry both units in their types
+
+template <class ExecutionPolicy, class T, class From, class To>
+void convert(
+    ExecutionPolicy policy,
+    quantity<T, From> const* first,
+    quantity<T, From> const* last,
+    quantity<T, To>* d_first)
+{
+  if (first == last) return;
+  static_assert(sizeof(quantity<T, From>) == sizeof(T), "quantity arrays must be arrays of values");
+  constexpr kul::conversion<T> c = details::static_unit_conversion<T, From, To>();
+  convert(policy, &(first->value()), &(first->value()) + (last - first), &(d_first->value()), c);
+}
+
+template <class ExecutionPolicy, class T, class From, class To>
+void simd_convert(
+    ExecutionPolicy policy,
+    quantity<T, From> const* first,
+    quantity<T, From> const* last,
+    quantity<T, To>* d_first)
+{
+  if (first == last) return;
+  static_assert(sizeof(quantity<T, From>) == sizeof(T), "quantity arrays must be arrays of values");
+  constexpr kul::conversion<T> c = details::static_unit_conversion<T, From, To>();
+  simd_convert(policy, &(first->value()), &(first->value()) + (last - first), &(d_first->value()), c);
+}
+
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "p3a_cg.hpp"
+
+using cg_type = p3a::preconditioned_conjugate_gradient<
+  double, p3a::device_allocator<double>, p3a::execution::parallel_policy>;
+using cg_array_type = cg_type::array_type;
+
+// 1D Laplacian with a small diagonal shift, which is SPD but poorly
+// conditioned, so plain CG needs many iterations
+inline void cg_laplacian_action(double shift, cg_array_type const& x, cg_array_type& y)
+{
+  auto const n = x.size();
+  auto const x_ptr = x.cbegin();
+  auto const y_ptr = y.begin();
+  p3a::for_each(p3a::execution::par,
+      p3a::counting_iterator<std::int64_t>(0),
+      p3a::counting_iterator<std::int64_t>(n),
+  [=] P3A_HOST_DEVICE (std::int64_t i) P3A_ALWAYS_INLINE {
+    double value = (2.0 + shift) * x_ptr[i];
+    if (i > 0) value -= x_ptr[i - 1];
+    if (i + 1 < n) value -= x_ptr[i + 1];
+    y_ptr[i] = value;
+  });
+}
+
+inline int cg_solve_laplacian(cg_type& solver, double shift, cg_array_type& x)
+{
+  return solver.solve(
+  [] (cg_array_type const& r, cg_array_type& z) {
+    p3a::copy(p3a::execution::par, r.cbegin(), r.cend(), z.begin());
+  },
+  [=] (cg_array_type const& in, cg_array_type& out) {
+    cg_laplacian_action(shift, in, out);
+  },
+  [] (cg_array_type& b) {
+    p3a::fill(p3a::execution::par, b.begin(), b.end(), 1.0);
+  },
+  x);
+}
+
+inline double cg_relative_residual(double shift, cg_array_type const& x)
+{
+  cg_array_type Ax(x.size());
+  cg_laplacian_action(shift, x, Ax);
+  p3a::dynamic_array<double> host_Ax(Ax);
+  double residual = 0.0;
+  for (auto const value : host_Ax) residual += p3a::square(value - 1.0);
+  return std::sqrt(residual / double(x.size()));
+}
+
+TEST(cg, deflation_reduces_iterations)
+{
+  int constexpr n = 200;
+  int constexpr step_count = 4;
+  cg_type plain;
+  plain.set_relative_tolerance(1.0e-10);
+  cg_type deflated;
+  deflated.set_relative_tolerance(1.0e-10);
+  deflated.set_deflation_dimension(8);
+  int plain_iterations = 0;
+  int deflated_iterations = 0;
+  for (int step = 0; step < step_count; ++step) {
+    double const shift = 1.0e-4 * (1.0 + 0.01 * step);
+    cg_array_type x_plain(n);
+    p3a::fill(p3a::execution::par, x_plain.begin(), x_plain.end(), 0.0);
+    cg_array_type x_deflated(x_plain);
+    int const plain_step = cg_solve_laplacian(plain, shift, x_plain);
+    int const deflated_step = cg_solve_laplacian(deflated, shift, x_deflated);
+    EXPECT_LT(cg_relative_residual(shift, x_plain), 1.0e-6);
+    EXPECT_LT(cg_relative_residual(shift, x_deflated), 1.0e-6);
+    if (step == 0) {
+      EXPECT_EQ(plain_step, deflated_step);
+    } else {
+      plain_iterations += plain_step;
+      deflated_iterations += deflated_step;
+    }
+  }
+  EXPECT_EQ(deflated.deflation_space_size(), 8);
+  EXPECT_LT(deflated_iterations, plain_iterations);
+}
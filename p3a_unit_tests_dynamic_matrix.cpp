@@ -0,0 +1,292 @@
+#include <gtest/gtest.h>
+
+#include <utility>
+
+#include "p3a_dynamic_matrix.hpp"
+#include "p3a_lu.hpp"
+#include "p3a_cholesky.hpp"
+#include "p3a_qr.hpp"
+
+template <class Matrix>
+void fill_dynamic_matrix(Matrix& a, int seed)
+{
+  for (int i = 0; i < a.row_count(); ++i) {
+    for (int j = 0; j < a.column_count(); ++j) {
+      a(i, j) = double((i * 37 + j * 11 + seed * 7) % 19) / 19.0 - 0.5;
+    }
+  }
+}
+
+template <class Matrix>
+void test_gemm(int m, int n, int k, bool lower_only = false)
+{
+  Matrix a(m, k);
+  Matrix b(k, n);
+  Matrix c(m, n);
+  fill_dynamic_matrix(a, 1);
+  fill_dynamic_matrix(b, 2);
+  fill_dynamic_matrix(c, 3);
+  Matrix expected(m, n);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double sum = 0.0;
+      for (int l = 0; l < k; ++l) sum += a(i, l) * b(l, j);
+      expected(i, j) = (lower_only && j > i) ? c(i, j) : (2.0 * sum - 0.5 * c(i, j));
+    }
+  }
+  if (lower_only) {
+    // only the internal entry point exposes lower_only (used by rank_k_update)
+    p3a::details::gemm(2.0, std::as_const(a).view(), std::as_const(b).view(), -0.5, c.view(), true);
+  } else {
+    p3a::gemm(2.0, a, b, -0.5, c);
+  }
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      EXPECT_NEAR(c(i, j), expected(i, j), 1.0e-10);
+    }
+  }
+}
+
+TEST(dynamic_matrix, gemm_small)
+{
+  test_gemm<p3a::dynamic_matrix<double>>(3, 5, 4);
+}
+
+TEST(dynamic_matrix, gemm_blocked)
+{
+  test_gemm<p3a::dynamic_matrix<double>>(131, 77, 301);
+  test_gemm<p3a::dynamic_matrix<double,
+    p3a::host_allocator<double>, p3a::execution::kokkos_serial_policy>>(261, 45, 270);
+}
+
+TEST(dynamic_matrix, gemm_lower_only)
+{
+  test_gemm<p3a::dynamic_matrix<double>>(5, 5, 3, true);
+  test_gemm<p3a::dynamic_matrix<double>>(131, 97, 301, true);
+  test_gemm<p3a::dynamic_matrix<double,
+    p3a::host_allocator<double>, p3a::execution::kokkos_serial_policy>>(150, 150, 270, true);
+}
+
+TEST(dynamic_matrix, gemv_and_rank_k_update)
+{
+  using matrix_type = p3a::dynamic_matrix<double>;
+  int constexpr n = 150;
+  int constexpr k = 90;
+  matrix_type a(n, k);
+  fill_dynamic_matrix(a, 4);
+  matrix_type x(k, 1);
+  fill_dynamic_matrix(x, 5);
+  matrix_type y;
+  p3a::gemv(1.0, a, x, 0.0, y);
+  matrix_type c;
+  p3a::rank_k_update(1.0, a, 0.0, c);
+  ASSERT_EQ(y.row_count(), n);
+  ASSERT_EQ(c.row_count(), n);
+  ASSERT_EQ(c.column_count(), n);
+  for (int i = 0; i < n; ++i) {
+    double y_i = 0.0;
+    for (int l = 0; l < k; ++l) y_i += a(i, l) * x(l, 0);
+    EXPECT_NEAR(y(i, 0), y_i, 1.0e-10);
+    for (int j = 0; j < n; ++j) {
+      double c_ij = 0.0;
+      for (int l = 0; l < k; ++l) c_ij += a(i, l) * a(j, l);
+      EXPECT_NEAR(c(i, j), c_ij, 1.0e-10);
+    }
+  }
+}
+
+TEST(dynamic_matrix, lu_factorization)
+{
+  using matrix_type = p3a::dynamic_matrix<double>;
+  int constexpr n = 150;
+  int constexpr rhs_count = 3;
+  matrix_type a(n, n);
+  fill_dynamic_matrix(a, 6);
+  for (int i = 0; i < n; ++i) a(i, i) += 0.5 + 0.01 * double(i);
+  matrix_type b(n, rhs_count);
+  fill_dynamic_matrix(b, 7);
+  p3a::lu_factorization<double> lu;
+  lu.set_block_size(16);
+  lu.factor(a);
+  EXPECT_FALSE(lu.is_singular());
+  matrix_type x;
+  lu.solve(b, x);
+  matrix_type ax;
+  p3a::multiply(a, x, ax);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < rhs_count; ++j) {
+      EXPECT_NEAR(ax(i, j), b(i, j), 1.0e-8);
+    }
+  }
+}
+
+TEST(dynamic_matrix, lu_determinant_and_condition)
+{
+  using matrix_type = p3a::dynamic_matrix<double>;
+  matrix_type a(3, 3);
+  a(0, 0) = 0.0; a(0, 1) = 2.0; a(0, 2) = 0.0;
+  a(1, 0) = 1.0; a(1, 1) = 0.0; a(1, 2) = 0.0;
+  a(2, 0) = 0.0; a(2, 1) = 0.0; a(2, 2) = 1.0e-3;
+  p3a::lu_factorization<double> lu(a);
+  EXPECT_NEAR(lu.determinant(), -2.0e-3, 1.0e-15);
+  EXPECT_NEAR(lu.condition_number_estimate(), 2.0e3, 1.0e-9);
+  a(2, 2) = 0.0;
+  lu.factor(a);
+  EXPECT_TRUE(lu.is_singular());
+  EXPECT_EQ(lu.determinant(), 0.0);
+  matrix_type b(3, 1);
+  EXPECT_THROW(lu.solve_in_place(b), std::invalid_argument);
+}
+
+TEST(dynamic_matrix, cholesky_and_ldlt)
+{
+  using matrix_type = p3a::dynamic_matrix<double>;
+  int constexpr n = 140;
+  int constexpr k = 60;
+  int constexpr rhs_count = 2;
+  matrix_type g(n, k);
+  fill_dynamic_matrix(g, 8);
+  matrix_type a;
+  p3a::rank_k_update(1.0, g, 0.0, a);
+  for (int i = 0; i < n; ++i) a(i, i) += 1.0;
+  matrix_type b(n, rhs_count);
+  fill_dynamic_matrix(b, 9);
+  p3a::cholesky_factorization<double> cholesky;
+  cholesky.set_block_size(24);
+  cholesky.factor(a);
+  ASSERT_TRUE(cholesky.is_positive_definite());
+  p3a::ldlt_factorization<double> ldlt;
+  ldlt.set_block_size(24);
+  ldlt.factor(a);
+  ASSERT_FALSE(ldlt.is_singular());
+  p3a::lu_factorization<double> lu(a);
+  EXPECT_NEAR(cholesky.determinant() / lu.determinant(), 1.0, 1.0e-8);
+  EXPECT_NEAR(ldlt.determinant() / lu.determinant(), 1.0, 1.0e-8);
+  matrix_type x_cholesky;
+  cholesky.solve(b, x_cholesky);
+  matrix_type x_ldlt;
+  ldlt.solve(b, x_ldlt);
+  matrix_type ax;
+  p3a::multiply(a, x_cholesky, ax);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < rhs_count; ++j) {
+      EXPECT_NEAR(ax(i, j), b(i, j), 1.0e-8);
+      EXPECT_NEAR(x_ldlt(i, j), x_cholesky(i, j), 1.0e-8);
+    }
+  }
+  for (int i = 0; i < n; ++i) a(i, i) -= 2.0;
+  cholesky.factor(a);
+  EXPECT_FALSE(cholesky.is_positive_definite());
+  EXPECT_THROW(cholesky.solve_in_place(b), std::invalid_argument);
+}
+
+TEST(dynamic_matrix, qr_least_squares)
+{
+  using matrix_type = p3a::dynamic_matrix<double>;
+  int constexpr m = 120;
+  int constexpr n = 45;
+  int constexpr rhs_count = 2;
+  matrix_type a(m, n);
+  fill_dynamic_matrix(a, 10);
+  for (int j = 0; j < n; ++j) a(j, j) += 1.0;
+  matrix_type b(m, rhs_count);
+  fill_dynamic_matrix(b, 11);
+  p3a::qr_factorization<double> qr;
+  qr.set_block_size(8);
+  qr.factor(a);
+  matrix_type x;
+  qr.least_squares_solve(b, x);
+  ASSERT_EQ(x.row_count(), n);
+  ASSERT_EQ(x.column_count(), rhs_count);
+  // the residual must be orthogonal to the columns of A
+  matrix_type residual = b;
+  p3a::gemm(-1.0, a, x, 1.0, residual);
+  for (int j = 0; j < n; ++j) {
+    for (int c = 0; c < rhs_count; ++c) {
+      double dot = 0.0;
+      for (int i = 0; i < m; ++i) dot += a(i, j) * residual(i, c);
+      EXPECT_NEAR(dot, 0.0, 1.0e-10);
+    }
+  }
+  // Q is orthogonal
+  matrix_type q(m, 3);
+  fill_dynamic_matrix(q, 12);
+  matrix_type q_original = q;
+  qr.apply_q_transpose(q);
+  qr.apply_q(q);
+  for (int i = 0; i < m; ++i) {
+    for (int c = 0; c < 3; ++c) {
+      EXPECT_NEAR(q(i, c), q_original(i, c), 1.0e-12);
+    }
+  }
+}
+
+TEST(dynamic_matrix, views_and_layouts)
+{
+  using row_major_matrix = p3a::dynamic_matrix<double>;
+  using column_major_matrix = p3a::dynamic_matrix<double,
+    p3a::host_allocator<double>, p3a::execution::sequenced_policy,
+    p3a::column_major_layout>;
+  int constexpr n = 70;
+  row_major_matrix a(n, n);
+  fill_dynamic_matrix(a, 13);
+  column_major_matrix a_column_major(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) a_column_major(i, j) = a(i, j);
+  }
+  EXPECT_EQ(a_column_major.view().data()[1], a(1, 0));
+  column_major_matrix aa_column_major;
+  p3a::multiply(a_column_major, a_column_major, aa_column_major);
+  // C = A^T applied to a block of A, written into a block of C, with no copies
+  int constexpr m = 40;
+  row_major_matrix c(n, n);
+  c.assign_zero();
+  p3a::gemm(1.0,
+      a.view().submatrix(10, 5, m, m).transpose(),
+      a.view().submatrix(20, 0, m, n),
+      0.0,
+      c.view().submatrix(n - m, 0, m, n));
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double aa = 0.0;
+      for (int l = 0; l < n; ++l) aa += a(i, l) * a(l, j);
+      EXPECT_NEAR(aa_column_major(i, j), aa, 1.0e-10);
+      double expected = 0.0;
+      if (i >= n - m) {
+        for (int l = 0; l < m; ++l) expected += a(10 + l, 5 + i - (n - m)) * a(20 + l, j);
+      }
+      EXPECT_NEAR(c(i, j), expected, 1.0e-10);
+    }
+  }
+  auto const row = a.view().row(3);
+  auto const column = a.view().column(4);
+  EXPECT_EQ(row.row_count(), 1);
+  EXPECT_EQ(row(0, 4), a(3, 4));
+  EXPECT_EQ(column.column_count(), 1);
+  EXPECT_EQ(column(3, 0), a(3, 4));
+}
+
+TEST(dynamic_matrix, element_wise_operations)
+{
+  using matrix_type = p3a::dynamic_matrix<double,
+    p3a::host_allocator<double>, p3a::execution::kokkos_serial_policy>;
+  matrix_type x(5, 4);
+  fill_dynamic_matrix(x, 14);
+  matrix_type y(5, 4);
+  y.assign_zero();
+  EXPECT_EQ(y(4, 3), 0.0);
+  matrix_type result;
+  p3a::axpy(2.0, x, y, result);
+  p3a::swap_rows(result, 1, 3);
+  for (int j = 0; j < 4; ++j) {
+    EXPECT_EQ(result(1, j), 2.0 * x(3, j));
+    EXPECT_EQ(result(3, j), 2.0 * x(1, j));
+    EXPECT_EQ(result(0, j), 2.0 * x(0, j));
+  }
+  double const* const original_data = result.data();
+  result.resize(2, 3);
+  result.resize(4, 5);
+  EXPECT_EQ(result.data(), original_data);
+  EXPECT_EQ(result.row_count(), 4);
+  EXPECT_EQ(result.column_count(), 5);
+}
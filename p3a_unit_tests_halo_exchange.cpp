@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+#include "p3a_halo_exchange.hpp"
+
+#include <vector>
+
+namespace {
+
+// what a ghost cell should hold: the value at its periodic image, if any
+double expected_value(
+    p3a::grid3 const& grid,
+    p3a::vector3<bool> const& periodic,
+    p3a::vector3<int> point,
+    double scale)
+{
+  for (int axis = 0; axis < 3; ++axis) {
+    int const extent = grid.extents()[axis];
+    if (periodic[axis]) point[axis] = ((point[axis] % extent) + extent) % extent;
+  }
+  if (!grid.contains(point)) return -1.0;
+  return scale * double(grid.index(point));
+}
+
+}
+
+// run under mpiexec with any number of ranks; each rank owns a slab along x
+TEST(halo_exchange, periodic_slabs)
+{
+  auto comm = mpicpp::comm::world();
+  int const rank = comm.rank();
+  int const size = comm.size();
+  p3a::grid3 const grid(8, 5, 4);
+  p3a::vector3<bool> const periodic(true, true, false);
+  int const ghost_width = 2;
+  p3a::subgrid3 const owned(
+      p3a::vector3<int>((rank * 8) / size, 0, 0),
+      p3a::vector3<int>(((rank + 1) * 8) / size, 5, 4));
+  p3a::halo_exchange<double> halo(std::move(comm), grid, owned, ghost_width, periodic);
+  auto const ghosted = halo.ghosted();
+  EXPECT_EQ(ghosted.extents(), owned.extents() + p3a::vector3<int>(4, 4, 4));
+  std::vector<double> field(std::size_t(ghosted.size()), -1.0);
+  for (double const scale : {1.0, 2.0}) {
+    p3a::for_each(p3a::execution::seq, owned,
+    [&] (p3a::vector3<int> const& point) {
+      field[std::size_t(ghosted.index(point))] = scale * double(grid.index(point));
+    });
+    halo.start(field.data());
+    halo.finish();
+    p3a::for_each(p3a::execution::seq, ghosted,
+    [&] (p3a::vector3<int> const& point) {
+      EXPECT_EQ(field[std::size_t(ghosted.index(point))],
+          expected_value(grid, periodic, point, scale));
+    });
+  }
+}
+
+TEST(halo_exchange, start_finish_pairing)
+{
+  auto comm = mpicpp::comm::world();
+  int const rank = comm.rank();
+  int const size = comm.size();
+  p3a::grid3 const grid(size, 1, 1);
+  p3a::subgrid3 const owned(
+      p3a::vector3<int>(rank, 0, 0),
+      p3a::vector3<int>(rank + 1, 1, 1));
+  p3a::halo_exchange<double> halo(std::move(comm), grid, owned, 1);
+  std::vector<double> field(std::size_t(halo.ghosted().size()), 0.0);
+  EXPECT_THROW(halo.finish(), std::logic_error);
+  halo.start(field.data());
+  EXPECT_THROW(halo.start(field.data()), std::logic_error);
+  halo.finish();
+  EXPECT_THROW(halo.finish(), std::logic_error);
+  halo.exchange(field.data());
+}
@@ -123,3 +123,125 @@ TEST(tensor, log)
   auto const tol     = 40 * eps;
   ASSERT_LE(error_a, tol);
 }
+
+using simd4_type = p3a::simd<double, p3a::simd_abi::fixed_size<4>>;
+
+// norms that select Padé orders 3 and 7, order 13, and order 13 with squaring
+static p3a::matrix3x3<double> const simd_test_lanes[4] = {
+  {1.0e-4, 2.0e-4, 0.0, -1.0e-4, 0.0, 3.0e-4, 0.0, 1.0e-4, -2.0e-4},
+  {0.1, 0.2, -0.1, 0.05, -0.2, 0.1, 0.0, 0.1, 0.15},
+  {1.0, 0.5, -0.5, 0.2, 1.5, 0.3, -0.4, 0.1, 2.0},
+  {2.0, 1.0, 0.5, -1.0, 3.0, 0.2, 0.3, -2.5, 2.5}};
+
+// one scalar matrix per SIMD lane
+static p3a::matrix3x3<simd4_type> pack_lanes(p3a::matrix3x3<double> const (&lanes)[4])
+{
+  p3a::matrix3x3<simd4_type> a;
+  for (int lane = 0; lane < 4; ++lane) {
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) a(i, j)[lane] = lanes[lane](i, j);
+    }
+  }
+  return a;
+}
+
+static void expect_lane_near(
+    p3a::matrix3x3<simd4_type> const& a,
+    int lane,
+    p3a::matrix3x3<double> const& expected,
+    double tolerance)
+{
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_NEAR(a(i, j)[lane], expected(i, j), tolerance);
+    }
+  }
+}
+
+TEST(tensor, exp_log_simd)
+{
+  auto const& lanes = simd_test_lanes;
+  auto const B = exp(pack_lanes(lanes));
+  auto const C = log(B);
+  for (int lane = 0; lane < 4; ++lane) {
+    auto const B_scalar = exp(lanes[lane]);
+    auto const C_scalar = log(B_scalar);
+    expect_lane_near(B, lane, B_scalar, 1.0e-14 * norm(B_scalar));
+    expect_lane_near(C, lane, C_scalar, 1.0e-12 * norm(C_scalar));
+    expect_lane_near(C, lane, lanes[lane], 1.0e-10 * norm(lanes[lane]));
+  }
+}
+
+TEST(tensor, exp_log_frechet)
+{
+  using Tensor = p3a::matrix3x3<double>;
+  // small enough for a low Padé order, and large enough to need squaring
+  Tensor const As[2] = {
+    {0.1, 0.2, -0.1, 0.05, -0.2, 0.1, 0.0, 0.1, 0.15},
+    {2.0, 1.0, 0.5, -1.0, 3.0, 0.2, 0.3, -2.5, 2.5}};
+  Tensor const E(0.3, -0.2, 0.1, 0.5, 0.4, -0.6, 0.2, 0.7, -0.1);
+  double const h = 1.0e-6;
+  for (auto const& A : As) {
+    auto const L = p3a::exp_frechet(A, E);
+    auto const L_fd = (exp(A + h * E) - exp(A - h * E)) / (2.0 * h);
+    EXPECT_LE(norm(L - L_fd), 1.0e-7 * norm(L));
+    auto const J = p3a::exp_tangent(A);
+    for (int i = 0; i < 9; ++i) {
+      double Je = 0.0;
+      for (int k = 0; k < 9; ++k) Je += J(i, k) * E(k / 3, k % 3);
+      EXPECT_NEAR(Je, L(i / 3, i % 3), 1.0e-12 * norm(L));
+    }
+  }
+  auto const B = Tensor(2.5, 0.5, 1, 0.5, 2.5, 1, 1, 1, 2) + 0.1 * E;
+  Tensor L;
+  EXPECT_FALSE(p3a::log_frechet(B, E, L));
+  auto const L_fd = (log(B + h * E) - log(B - h * E)) / (2.0 * h);
+  EXPECT_LE(norm(L - L_fd), 1.0e-7 * norm(L));
+  p3a::static_matrix<double, 9, 9> K;
+  EXPECT_FALSE(p3a::log_tangent(B, K));
+  for (int i = 0; i < 9; ++i) {
+    double Ke = 0.0;
+    for (int k = 0; k < 9; ++k) Ke += K(i, k) * E(k / 3, k % 3);
+    EXPECT_NEAR(Ke, L(i / 3, i % 3), 1.0e-12 * norm(L));
+  }
+}
+
+TEST(tensor, exp_log_tangent_mandel)
+{
+  using Tensor = p3a::matrix3x3<double>;
+  p3a::symmetric3x3<double> const S(2.5, 0.5, 1.0, 2.5, 1.0, 2.0);
+  Tensor const A(S);
+  double const r2 = std::sqrt(2.0);
+  // unit symmetric directions xx and yz in the orthonormal Mandel basis
+  Tensor const E_xx(1, 0, 0, 0, 0, 0, 0, 0, 0);
+  Tensor const E_yz(0, 0, 0, 0, 0, 1 / r2, 0, 1 / r2, 0);
+  auto const C = p3a::exp_tangent(S);
+  auto const L_xx = p3a::exp_frechet(A, E_xx);
+  auto const L_yz = p3a::exp_frechet(A, E_yz);
+  double const tol = 1.0e-12 * norm(L_xx);
+  EXPECT_NEAR(C.x11(), L_xx(0, 0), tol);
+  EXPECT_NEAR(C.x41(), r2 * L_xx(1, 2), tol);
+  EXPECT_NEAR(C.x14(), L_yz(0, 0), tol);
+  EXPECT_NEAR(C.x44(), r2 * L_yz(1, 2), tol);
+  EXPECT_NEAR(C.x64(), r2 * L_yz(0, 1), tol);
+  EXPECT_NEAR(C.x14(), C.x41(), tol);
+  // the log tangent at exp(S) inverts the exp tangent at S
+  p3a::mandel6x6<double> D;
+  EXPECT_FALSE(p3a::log_tangent(p3a::symmetric_part(exp(A)), D));
+  auto const CD = C * D;
+  EXPECT_NEAR(CD.x11(), 1.0, 1.0e-10);
+  EXPECT_NEAR(CD.x44(), 1.0, 1.0e-10);
+  EXPECT_NEAR(CD.x14(), 0.0, 1.0e-10);
+  EXPECT_NEAR(CD.x65(), 0.0, 1.0e-10);
+}
+
+TEST(tensor, exp_frechet_simd)
+{
+  auto const& lanes = simd_test_lanes;
+  p3a::matrix3x3<double> const E(0.3, -0.2, 0.1, 0.5, 0.4, -0.6, 0.2, 0.7, -0.1);
+  auto const L = p3a::exp_frechet(pack_lanes(lanes), pack_lanes({E, E, E, E}));
+  for (int lane = 0; lane < 4; ++lane) {
+    auto const L_scalar = p3a::exp_frechet(lanes[lane], E);
+    expect_lane_near(L, lane, L_scalar, 1.0e-14 * norm(L_scalar));
+  }
+}
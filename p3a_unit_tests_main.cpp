@@ -1,8 +1,15 @@
+#include <mpi.h>
 #include <Kokkos_Core.hpp>
 #include "gtest/gtest.h"
 
 int main(int argc, char **argv) {
+  MPI_Init(&argc, &argv);
   ::testing::InitGoogleTest(&argc, argv);
-  Kokkos::ScopeGuard kokkos_library_state(argc, argv);
-  return RUN_ALL_TESTS();
+  int result;
+  {
+    Kokkos::ScopeGuard kokkos_library_state(argc, argv);
+    result = RUN_ALL_TESTS();
+  }
+  MPI_Finalize();
+  return result;
 }
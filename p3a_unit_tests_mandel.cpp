@@ -2,6 +2,8 @@
 #include "p3a_mandel3x6.hpp"
 #include "p3a_mandel6x3.hpp"
 #include "p3a_mandel6x6.hpp"
+#include "p3a_symmetric_mandel6x6.hpp"
+#include "p3a_isotropic6x6.hpp"
 
 using Y = double;
 
@@ -2259,3 +2261,252 @@ TEST(mandel_tensors,LinAlg3rdOrder63e63xV6){
     EXPECT_FLOAT_EQ(0.4433849126439117,f.x62()) << "e.x62()";
     EXPECT_FLOAT_EQ(0.4539125712913405,f.x63()) << "e.x63()";
 }
+
+/**************************************************************************
+ * Test symmetric_mandel6x6
+ *************************************************************************/
+TEST(mandel_tensors,SymmetricMandel6x6Storage){
+
+    EXPECT_EQ(sizeof(p3a::symmetric_mandel6x6<Y>),
+              std::size_t(p3a::symmetric_mandel6x6_component_count) * sizeof(Y));
+
+    TestData td;
+    // major-symmetric part of C, before the Mandel transform
+    p3a::symmetric_mandel6x6<Y> S = p3a::symmetric_part(td.C);
+    p3a::mandel6x6<Y> F = p3a::full(S);
+    p3a::mandel6x6<Y> Fx(
+        S.x11(), S.x12(), S.x13(), S.x14(), S.x15(), S.x16(),
+        S.x21(), S.x22(), S.x23(), S.x24(), S.x25(), S.x26(),
+        S.x31(), S.x32(), S.x33(), S.x34(), S.x35(), S.x36(),
+        S.x41(), S.x42(), S.x43(), S.x44(), S.x45(), S.x46(),
+        S.x51(), S.x52(), S.x53(), S.x54(), S.x55(), S.x56(),
+        S.x61(), S.x62(), S.x63(), S.x64(), S.x65(), S.x66());
+    p3a::symmetric_mandel6x6<Y> Sx(
+        S.x11(), S.x12(), S.x13(), S.x14(), S.x15(), S.x16(),
+                 S.x22(), S.x23(), S.x24(), S.x25(), S.x26(),
+                          S.x33(), S.x34(), S.x35(), S.x36(),
+                                   S.x44(), S.x45(), S.x46(),
+                                            S.x55(), S.x56(),
+                                                     S.x66());
+    EXPECT_FLOAT_EQ(0.5*(td.C.x14() + td.C.x41()), S.x41()) << "S.x41()";
+    EXPECT_FLOAT_EQ(F.x35(), S.x53()) << "F.x35()";
+    // the transform is applied on construction like for mandel6x6
+    EXPECT_FLOAT_EQ(Fx.x11(), Sx.x11()) << "Sx.x11()";
+    EXPECT_FLOAT_EQ(Fx.x15(), Sx.x51()) << "Sx.x51()";
+    EXPECT_FLOAT_EQ(Fx.x46(), Sx.x64()) << "Sx.x64()";
+    Sx.invMandelXform();
+    EXPECT_FLOAT_EQ(S.x46(), Sx.x46()) << "Sx.x46()";
+
+    p3a::mandel6x1<Y> v = S*td.V;
+    p3a::mandel6x1<Y> w = F*td.V;
+    EXPECT_FLOAT_EQ(w.x1(), v.x1()) << "v.x1()";
+    EXPECT_FLOAT_EQ(w.x4(), v.x4()) << "v.x4()";
+    EXPECT_FLOAT_EQ(w.x6(), v.x6()) << "v.x6()";
+
+    p3a::symmetric_mandel6x6<Y> D = Y(2.0)*S - S/Y(2.0) + (-S);
+    D += S;
+    D -= Y(0.5)*S;
+    D *= Y(2.0);
+    EXPECT_FLOAT_EQ(2.0*S.x25(), D.x52()) << "D.x52()";
+    EXPECT_FLOAT_EQ(2.0*trace(S), trace(D)) << "trace(D)";
+}
+
+TEST(mandel_tensors,SymmetricMandel6x6Inverse){
+
+    TestData td;
+    // C C^T + I is positive definite, while the symmetric part of C is not
+    p3a::symmetric_mandel6x6<Y> A =
+        p3a::symmetric_part(td.C*p3a::transpose(td.C)) + p3a::symmetric_mandel6x6<Y>::identity();
+    p3a::symmetric_mandel6x6<Y> S = p3a::symmetric_part(td.C);
+    p3a::symmetric_mandel6x6<Y> Ainv = p3a::inverse_spd(A);
+    p3a::symmetric_mandel6x6<Y> Ainv_lu = p3a::inverse(A);
+    p3a::symmetric_mandel6x6<Y> Sinv = p3a::inverse(S);
+    Y const tol = Y(100.0)*p3a::epsilon_value<Y>();
+    // the same convention as the inverse of the full tensor
+    p3a::mandel6x6<Y> const Afull_inv = inverse(full(A));
+    p3a::mandel6x6<Y> const Sfull_inv = inverse(full(S));
+    EXPECT_NEAR(Afull_inv.x11(), Ainv.x11(), tol) << "Ainv.x11()";
+    EXPECT_NEAR(Afull_inv.x25(), Ainv.x25(), tol) << "Ainv.x25()";
+    EXPECT_NEAR(Afull_inv.x44(), Ainv.x44(), tol) << "Ainv.x44()";
+    EXPECT_NEAR(Afull_inv.x64(), Ainv.x64(), tol) << "Ainv.x64()";
+    EXPECT_NEAR(Afull_inv.x44(), Ainv_lu.x44(), tol) << "Ainv_lu.x44()";
+    EXPECT_NEAR(Afull_inv.x31(), Ainv_lu.x31(), tol) << "Ainv_lu.x31()";
+    EXPECT_NEAR(Sfull_inv.x11(), Sinv.x11(), 10*tol) << "Sinv.x11()";
+    EXPECT_NEAR(Sfull_inv.x45(), Sinv.x45(), 10*tol) << "Sinv.x45()";
+    EXPECT_NEAR(Sfull_inv.x66(), Sinv.x66(), 10*tol) << "Sinv.x66()";
+    // in Voigt form it is the matrix inverse
+    p3a::mandel6x6<Y> At = full(A);
+    p3a::mandel6x6<Y> Ainvt = full(Ainv);
+    At.invMandelXform();
+    Ainvt.invMandelXform();
+    p3a::mandel6x6<Y> I = At*Ainvt;
+    EXPECT_NEAR(1.0, I.x55(), tol) << "I.x55()";
+    EXPECT_NEAR(0.0, I.x35(), tol) << "I.x35()";
+    EXPECT_NEAR(0.0, I.x46(), tol) << "I.x46()";
+}
+
+TEST(mandel_tensors,LinAlg4thOrderMandelTensorFastInverses){
+
+    TestData td;
+    // C C^T + I is positive definite
+    p3a::mandel6x6<Y> A = td.C*p3a::transpose(td.C);
+    A.x11() += 1.0; A.x22() += 1.0; A.x33() += 1.0;
+    A.x44() += 1.0; A.x55() += 1.0; A.x66() += 1.0;
+    p3a::mandel6x6<Y> const cubic = p3a::cubic_mandel6x6(Y(170.0), Y(124.0), Y(75.0));
+    p3a::mandel6x6<Y> const isotropic = p3a::isotropic_mandel6x6(Y(160.0), Y(79.0));
+    p3a::mandel6x6<Y> const pairs[][2] = {
+        {inverse(A), p3a::inverse_spd(A)},
+        {inverse(A), inverse(A, p3a::mandel6x6_symmetry::positive_definite)},
+        {inverse(cubic), p3a::inverse_cubic(Y(170.0), Y(124.0), Y(75.0))},
+        {inverse(cubic), inverse(cubic, p3a::mandel6x6_symmetry::cubic)},
+        {inverse(isotropic), p3a::inverse_isotropic(Y(160.0), Y(79.0))},
+        {inverse(isotropic), inverse(isotropic, p3a::mandel6x6_symmetry::isotropic)},
+        {inverse(A), inverse(A, p3a::mandel6x6_symmetry::general)}};
+    for (auto const& pair : pairs) {
+        auto const& e = pair[0];
+        auto const& f = pair[1];
+        Y const tol = Y(100.0)*p3a::epsilon_value<Y>()*p3a::abs(e.x11());
+        EXPECT_NEAR(e.x11(),f.x11(),tol) << "f.x11()";
+        EXPECT_NEAR(e.x12(),f.x12(),tol) << "f.x12()";
+        EXPECT_NEAR(e.x21(),f.x21(),tol) << "f.x21()";
+        EXPECT_NEAR(e.x33(),f.x33(),tol) << "f.x33()";
+        EXPECT_NEAR(e.x35(),f.x35(),tol) << "f.x35()";
+        EXPECT_NEAR(e.x44(),f.x44(),tol) << "f.x44()";
+        EXPECT_NEAR(e.x46(),f.x46(),tol) << "f.x46()";
+        EXPECT_NEAR(e.x53(),f.x53(),tol) << "f.x53()";
+        EXPECT_NEAR(e.x66(),f.x66(),tol) << "f.x66()";
+    }
+    // what inverse(V, symmetry) asserts about V in debug builds
+    EXPECT_TRUE(p3a::details::has_cubic_symmetry(cubic));
+    EXPECT_FALSE(p3a::details::has_isotropic_symmetry(cubic));
+    EXPECT_TRUE(p3a::details::has_cubic_symmetry(isotropic));
+    EXPECT_TRUE(p3a::details::has_isotropic_symmetry(isotropic));
+    EXPECT_FALSE(p3a::details::has_cubic_symmetry(A));
+}
+
+TEST(mandel_tensors,Isotropic6x6Algebra){
+
+    TestData td;
+    auto const C = p3a::isotropic6x6<Y>::from_bulk_and_shear(Y(160.0), Y(79.0));
+    auto const D = p3a::isotropic6x6<Y>::from_lame(Y(55.0), Y(26.0));
+    p3a::mandel6x6<Y> const Cf = C.full();
+    p3a::mandel6x6<Y> const reference = p3a::isotropic_mandel6x6(Y(160.0), Y(79.0));
+    Y const tol = Y(100.0)*p3a::epsilon_value<Y>()*Cf.x11();
+    EXPECT_NEAR(reference.x11(), Cf.x11(), tol) << "Cf.x11()";
+    EXPECT_NEAR(reference.x23(), Cf.x23(), tol) << "Cf.x23()";
+    EXPECT_NEAR(reference.x55(), Cf.x55(), tol) << "Cf.x55()";
+    EXPECT_NEAR(reference.x45(), Cf.x45(), tol) << "Cf.x45()";
+    EXPECT_NEAR(Y(55.0), D.lame(), tol) << "D.lame()";
+    EXPECT_NEAR(Y(26.0), D.shear(), tol) << "D.shear()";
+
+    p3a::mandel6x1<Y> const v = C*td.V;
+    p3a::mandel6x1<Y> const w = Cf*td.V;
+    EXPECT_NEAR(w.x1(), v.x1(), tol) << "v.x1()";
+    EXPECT_NEAR(w.x3(), v.x3(), tol) << "v.x3()";
+    EXPECT_NEAR(w.x4(), v.x4(), tol) << "v.x4()";
+    EXPECT_NEAR(w.x6(), v.x6(), tol) << "v.x6()";
+
+    p3a::mandel6x6<Y> const CD = (C*D).full();
+    p3a::mandel6x6<Y> const CfDf = Cf*D.full();
+    Y const tol2 = tol*D.full().x11();
+    EXPECT_NEAR(CfDf.x11(), CD.x11(), tol2) << "CD.x11()";
+    EXPECT_NEAR(CfDf.x12(), CD.x12(), tol2) << "CD.x12()";
+    EXPECT_NEAR(CfDf.x66(), CD.x66(), tol2) << "CD.x66()";
+
+    p3a::mandel6x1<Y> const u = tensor_inverse(C)*v;
+    EXPECT_NEAR(td.V.x1(), u.x1(), tol) << "u.x1()";
+    EXPECT_NEAR(td.V.x2(), u.x2(), tol) << "u.x2()";
+    EXPECT_NEAR(td.V.x5(), u.x5(), tol) << "u.x5()";
+
+    // inverse() agrees with the inverse of the full tensor
+    p3a::mandel6x6<Y> const Cinv = inverse(C);
+    p3a::mandel6x6<Y> const Cf_inv = inverse(Cf);
+    p3a::mandel6x6<Y> const Cinv_closed = p3a::inverse_isotropic(Y(160.0), Y(79.0));
+    Y const tol_inv = Y(100.0)*p3a::epsilon_value<Y>()*Cf_inv.x44();
+    EXPECT_NEAR(Cf_inv.x11(), Cinv.x11(), tol_inv) << "Cinv.x11()";
+    EXPECT_NEAR(Cf_inv.x12(), Cinv.x12(), tol_inv) << "Cinv.x12()";
+    EXPECT_NEAR(Cf_inv.x44(), Cinv.x44(), tol_inv) << "Cinv.x44()";
+    EXPECT_NEAR(Cf_inv.x66(), Cinv.x66(), tol_inv) << "Cinv.x66()";
+    EXPECT_NEAR(Cinv_closed.x11(), Cinv.x11(), tol_inv) << "Cinv_closed.x11()";
+    EXPECT_NEAR(Cinv_closed.x55(), Cinv.x55(), tol_inv) << "Cinv_closed.x55()";
+
+    p3a::isotropic6x6<Y> const E = Y(2.0)*C - D/Y(2.0) + (-C);
+    EXPECT_NEAR(C.volumetric() - 0.5*D.volumetric(), E.volumetric(), tol) << "E.volumetric()";
+    EXPECT_NEAR(C.deviatoric() - 0.5*D.deviatoric(), E.deviatoric(), tol) << "E.deviatoric()";
+}
+
+TEST(mandel_tensors,TransverselyIsotropic6x6Algebra){
+
+    TestData td;
+    // about the z axis the Walpole form must match the Voigt stiffness
+    p3a::vector3<Y> const z(0.0, 0.0, 1.0);
+    auto const Cz = p3a::transversely_isotropic6x6<Y>::from_voigt(
+        z, Y(165.0), Y(50.0), Y(65.0), Y(62.0), Y(40.0));
+    p3a::mandel6x6<Y> const Czf = Cz.full();
+    p3a::mandel6x6<Y> const reference(
+        165.0, 50.0, 65.0, 0.0,  0.0,  0.0,
+        50.0, 165.0, 65.0, 0.0,  0.0,  0.0,
+        65.0,  65.0, 62.0, 0.0,  0.0,  0.0,
+        0.0,   0.0,  0.0, 40.0,  0.0,  0.0,
+        0.0,   0.0,  0.0,  0.0, 40.0,  0.0,
+        0.0,   0.0,  0.0,  0.0,  0.0, 57.5);
+    Y const tol = Y(1000.0)*p3a::epsilon_value<Y>();
+    EXPECT_NEAR(reference.x11(), Czf.x11(), tol*165.0) << "Czf.x11()";
+    EXPECT_NEAR(reference.x12(), Czf.x12(), tol*165.0) << "Czf.x12()";
+    EXPECT_NEAR(reference.x13(), Czf.x13(), tol*165.0) << "Czf.x13()";
+    EXPECT_NEAR(reference.x33(), Czf.x33(), tol*165.0) << "Czf.x33()";
+    EXPECT_NEAR(reference.x44(), Czf.x44(), tol*165.0) << "Czf.x44()";
+    EXPECT_NEAR(reference.x55(), Czf.x55(), tol*165.0) << "Czf.x55()";
+    EXPECT_NEAR(reference.x66(), Czf.x66(), tol*165.0) << "Czf.x66()";
+    EXPECT_NEAR(0.0, Czf.x14(), tol*165.0) << "Czf.x14()";
+
+    // an isotropic tensor is transversely isotropic about any axis
+    p3a::vector3<Y> const n = p3a::normalize(p3a::vector3<Y>(1.0, -2.0, 0.5));
+    auto const I = p3a::isotropic6x6<Y>::from_bulk_and_shear(Y(160.0), Y(79.0));
+    p3a::mandel6x6<Y> const If = p3a::transversely_isotropic6x6<Y>(n, I).full();
+    EXPECT_NEAR(I.full().x12(), If.x12(), tol*160.0) << "If.x12()";
+    EXPECT_NEAR(I.full().x44(), If.x44(), tol*160.0) << "If.x44()";
+    EXPECT_NEAR(0.0, If.x15(), tol*160.0) << "If.x15()";
+
+    // a general axis: compare against the full Mandel tensors
+    auto const C = p3a::transversely_isotropic6x6<Y>::from_voigt(
+        n, Y(165.0), Y(50.0), Y(65.0), Y(62.0), Y(40.0));
+    auto const D = p3a::transversely_isotropic6x6<Y>(n,
+        Y(3.0), Y(2.0), Y(0.5), Y(-0.25), Y(1.5), Y(0.75));
+    p3a::mandel6x6<Y> const Cf = C.full();
+    p3a::mandel6x6<Y> const Df = D.full();
+    EXPECT_NEAR(Cf.x25(), Cf.x52(), tol*165.0) << "Cf.x52()";
+    p3a::mandel6x1<Y> const v = C*td.V;
+    p3a::mandel6x1<Y> const w = Cf*td.V;
+    EXPECT_NEAR(w.x1(), v.x1(), tol*165.0) << "v.x1()";
+    EXPECT_NEAR(w.x2(), v.x2(), tol*165.0) << "v.x2()";
+    EXPECT_NEAR(w.x4(), v.x4(), tol*165.0) << "v.x4()";
+    EXPECT_NEAR(w.x6(), v.x6(), tol*165.0) << "v.x6()";
+
+    p3a::mandel6x6<Y> const CD = (C*D).full();
+    p3a::mandel6x6<Y> const CfDf = Cf*Df;
+    EXPECT_NEAR(CfDf.x11(), CD.x11(), tol*500.0) << "CD.x11()";
+    EXPECT_NEAR(CfDf.x26(), CD.x26(), tol*500.0) << "CD.x26()";
+    EXPECT_NEAR(CfDf.x62(), CD.x62(), tol*500.0) << "CD.x62()";
+    EXPECT_NEAR(CfDf.x45(), CD.x45(), tol*500.0) << "CD.x45()";
+    EXPECT_NEAR(Df.x13(), transpose(D).full().x31(), tol) << "transpose(D)";
+
+    p3a::mandel6x1<Y> const u = tensor_inverse(C)*v;
+    EXPECT_NEAR(td.V.x1(), u.x1(), tol) << "u.x1()";
+    EXPECT_NEAR(td.V.x3(), u.x3(), tol) << "u.x3()";
+    EXPECT_NEAR(td.V.x5(), u.x5(), tol) << "u.x5()";
+    p3a::mandel6x6<Y> const DinvD = (tensor_inverse(D)*D).full();
+    EXPECT_NEAR(1.0, DinvD.x22(), tol) << "DinvD.x22()";
+    EXPECT_NEAR(0.0, DinvD.x23(), tol) << "DinvD.x23()";
+    EXPECT_NEAR(1.0, DinvD.x66(), tol) << "DinvD.x66()";
+
+    // inverse() agrees with the inverse of the full tensor
+    p3a::mandel6x6<Y> const Cinv = inverse(C);
+    p3a::mandel6x6<Y> const Cf_inv = inverse(Cf);
+    EXPECT_NEAR(Cf_inv.x11(), Cinv.x11(), tol) << "Cinv.x11()";
+    EXPECT_NEAR(Cf_inv.x13(), Cinv.x13(), tol) << "Cinv.x13()";
+    EXPECT_NEAR(Cf_inv.x25(), Cinv.x25(), tol) << "Cinv.x25()";
+    EXPECT_NEAR(Cf_inv.x44(), Cinv.x44(), tol) << "Cinv.x44()";
+    EXPECT_NEAR(Cf_inv.x46(), Cinv.x46(), tol) << "Cinv.x46()";
+    EXPECT_NEAR(Cf_inv.x63(), Cinv.x63(), tol) << "Cinv.x63()";
+}
@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 
+#include <vector>
+
 #include "p3a_polar.hpp"
 #include "p3a_counting_iterator.hpp"
 #include "p3a_for_each.hpp"
@@ -118,3 +120,79 @@ TEST(polar, accuracy)
   printf("(det(R) - 1) for accurate algorithm %.17e\n", err);
   EXPECT_LT(err, 1.0e-10);
 }
+
+TEST(polar, masked_fast)
+{
+  using simd_type = p3a::simd<double, p3a::simd_abi::fixed_size<4>>;
+  p3a::matrix3x3<double> const lanes[4] = {
+    {1.0, std::sqrt(2.0), 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0},
+    {2.0, 0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0, 2.0},
+    {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, -1.0},
+    {1.2, 0.3, -0.4, 0.1, 0.9, 0.2, 0.5, -0.1, 1.1}};
+  p3a::matrix3x3<simd_type> F;
+  for (int lane = 0; lane < 4; ++lane) {
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) F(i, j)[lane] = lanes[lane](i, j);
+    }
+  }
+  p3a::matrix3x3<simd_type> R;
+  auto const status = p3a::masked_polar_rotation_fast(F, R);
+  EXPECT_FALSE(status.singular[0]);
+  EXPECT_FALSE(status.singular[1]);
+  EXPECT_TRUE(status.singular[2]);
+  EXPECT_FALSE(status.singular[3]);
+  EXPECT_TRUE(p3a::none_of(status.no_converge));
+  for (int lane : {0, 1, 3}) {
+    p3a::matrix3x3<double> R_scalar;
+    auto const error_code = p3a::polar_rotation_fast(lanes[lane], R_scalar);
+    EXPECT_EQ(error_code, p3a::polar_errc::success);
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        EXPECT_EQ(R(i, j)[lane], R_scalar(i, j));
+      }
+    }
+  }
+}
+
+TEST(polar, batched_right_and_left)
+{
+  int constexpr count = 6;
+  std::vector<double> F(9 * count);
+  for (int s = 0; s < count; ++s) {
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        F[(3 * i + j) * count + s] = ((i == j) ? 1.0 : 0.0) + 0.1 * double((s + 2 * i + 3 * j) % 5) - 0.2;
+      }
+    }
+  }
+  // make the last one singular
+  for (int k = 0; k < 9; ++k) F[k * count + count - 1] = 0.0;
+  std::vector<double> R(9 * count);
+  std::vector<double> U(6 * count);
+  std::vector<double> V(6 * count);
+  std::vector<p3a::polar_errc> errors(count);
+  p3a::batched_decompose_polar_right(p3a::execution::kokkos_serial,
+      count, F.data(), R.data(), U.data(), errors.data());
+  for (int s = 0; s < count - 1; ++s) {
+    EXPECT_EQ(errors[s], p3a::polar_errc::success);
+    auto const F_s = p3a::load_matrix3x3(F.data(), count, s);
+    auto const R_s = p3a::load_matrix3x3(R.data(), count, s);
+    auto const U_s = p3a::load_symmetric3x3(U.data(), count, s);
+    auto const RU = R_s * p3a::matrix3x3<double>(U_s);
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) EXPECT_NEAR(RU(i, j), F_s(i, j), 1.0e-10);
+    }
+  }
+  EXPECT_EQ(errors[count - 1], p3a::polar_errc::singular);
+  p3a::batched_decompose_polar_left(p3a::execution::kokkos_serial,
+      count, F.data(), V.data(), R.data(), errors.data());
+  for (int s = 0; s < count - 1; ++s) {
+    auto const F_s = p3a::load_matrix3x3(F.data(), count, s);
+    auto const R_s = p3a::load_matrix3x3(R.data(), count, s);
+    auto const V_s = p3a::load_symmetric3x3(V.data(), count, s);
+    auto const VR = p3a::matrix3x3<double>(V_s) * R_s;
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) EXPECT_NEAR(VR(i, j), F_s(i, j), 1.0e-10);
+    }
+  }
+}
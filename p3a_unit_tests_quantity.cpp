@@ -0,0 +1,151 @@
+#include "gtest/gtest.h"
+#include "p3a_unit_conversion.hpp"
+#include "p3a_quantity_array.hpp"
+
+#include <vector>
+
+TEST(unit_conversion, raw_arrays)
+{
+  int constexpr count = 11;
+  std::vector<double> density(count);
+  for (int i = 0; i < count; ++i) density[std::size_t(i)] = 1.0 + 0.5 * i;
+  std::vector<double> converted(count);
+  std::vector<double> simd_converted(count);
+  p3a::convert(p3a::execution::kokkos_serial,
+      density.data(), density.data() + count, converted.data(),
+      kul::gram_per_cubic_centimeter(), kul::kilogram_per_cubic_meter());
+  p3a::simd_convert(p3a::execution::kokkos_serial,
+      density.data(), density.data() + count, simd_converted.data(),
+      kul::dynamic_unit(kul::gram_per_cubic_centimeter()),
+      kul::interned_unit(kul::kilogram_per_cubic_meter()));
+  for (int i = 0; i < count; ++i) {
+    EXPECT_DOUBLE_EQ(converted[std::size_t(i)], 1000.0 * density[std::size_t(i)]);
+    EXPECT_EQ(simd_converted[std::size_t(i)], converted[std::size_t(i)]);
+  }
+  std::vector<double> temperature = {0.0, 1.0, 100.0, 273.15, -40.0};
+  auto const original = temperature;
+  auto expected = temperature;
+  p3a::simd_convert_in_place(p3a::execution::kokkos_serial,
+      temperature.data(), temperature.data() + temperature.size(),
+      kul::temperature_electronvolt(), kul::kelvin());
+  p3a::convert_in_place(p3a::execution::kokkos_serial,
+      expected.data(), expected.data() + expected.size(),
+      kul::temperature_electronvolt(), kul::kelvin());
+  for (std::size_t i = 0; i < temperature.size(); ++i) {
+    EXPECT_EQ(temperature[i], expected[i]);
+    EXPECT_EQ(expected[i],
+        (kul::static_conversion<double, kul::temperature_electronvolt, kul::kelvin>()(original[i])));
+  }
+  EXPECT_THROW(p3a::convert(p3a::execution::kokkos_serial,
+      density.data(), density.data() + count, converted.data(),
+      kul::dynamic_unit(kul::meter()), kul::dynamic_unit(kul::second())),
+      std::runtime_error);
+  auto const kelvin_difference = kul::interned_unit::named("dK", kul::temperature(), kul::rational(1));
+  EXPECT_THROW(p3a::convert_in_place(p3a::execution::kokkos_serial,
+      temperature.data(), temperature.data() + temperature.size(),
+      kul::interned_unit(kul::kelvin()), kelvin_difference),
+      std::runtime_error);
+}
+
+TEST(unit_conversion, quantity_arrays)
+{
+  int constexpr count = 6;
+  std::vector<p3a::pascals<double>> stress(count);
+  for (int i = 0; i < count; ++i) stress[std::size_t(i)] = p3a::pascals<double>(1.0e9 * i - 2.0e9);
+  std::vector<p3a::gigapascals<double>> output(count);
+  p3a::simd_convert(p3a::execution::kokkos_serial,
+      stress.data(), stress.data() + count, output.data());
+  for (int i = 0; i < count; ++i) {
+    EXPECT_DOUBLE_EQ(output[std::size_t(i)].value(), double(i) - 2.0);
+    EXPECT_EQ(output[std::size_t(i)].value(), p3a::gigapascals<double>(stress[std::size_t(i)]).value());
+  }
+  std::vector<p3a::pascals<double>> round_trip(count);
+  p3a::convert(p3a::execution::kokkos_serial,
+      output.data(), output.data() + count, round_trip.data());
+  for (int i = 0; i < count; ++i) {
+    EXPECT_DOUBLE_EQ(round_trip[std::size_t(i)].value(), stress[std::size_t(i)].value());
+  }
+}
+
+inline void compute_work(
+    p3a::quantity_array<double, p3a::pascal> const& pressure,
+    p3a::quantity_array<double, p3a::cubic_meter> const& volume,
+    p3a::quantity_array<double, p3a::joule>& work)
+{
+  using simd_abi_type = p3a::execution::kokkos_serial_policy::simd_abi_type;
+  using mask_type = p3a::simd_mask<double, simd_abi_type>;
+  auto const p = pressure.data();
+  auto const v = volume.data();
+  auto const w = work.data();
+  p3a::simd_for_each<double>(p3a::execution::kokkos_serial,
+      p3a::counting_iterator<int>(0),
+      p3a::counting_iterator<int>(int(work.size())),
+  [=] P3A_HOST_DEVICE (int i, mask_type const& mask) P3A_ALWAYS_INLINE {
+    auto const p_i = p3a::load(p, i, mask);
+    static_assert(std::is_same_v<std::remove_const_t<decltype(p_i)>,
+        p3a::quantity<p3a::simd<double, simd_abi_type>, p3a::pascal>>,
+        "loads from quantity arrays are quantity batches");
+    auto const w_i = p3a::quantity<p3a::simd<double, simd_abi_type>, p3a::joule>(p_i * p3a::load(v, i, mask));
+    p3a::store(w_i, w, i, mask);
+  });
+}
+
+TEST(quantity_array, simd)
+{
+  int constexpr count = 9;
+  p3a::quantity_array<double, p3a::pascal> pressure(count);
+  p3a::quantity_array<double, p3a::cubic_meter> volume(count);
+  for (int i = 0; i < count; ++i) {
+    pressure[i] = p3a::pascals<double>(1.0e5 * (i + 1));
+    volume[i] = p3a::cubic_meters<double>(0.5 * i);
+  }
+  p3a::quantity_array<double, p3a::joule> work(count);
+  compute_work(pressure, volume, work);
+  for (int i = 0; i < count; ++i) {
+    EXPECT_DOUBLE_EQ(work[i].value(), 1.0e5 * (i + 1) * 0.5 * i);
+  }
+}
+
+inline void double_stress(
+    p3a::quantity_simd_view<double**, p3a::gigapascal> const& stress,
+    p3a::quantity_simd_view<double**, p3a::gigapascal> const& total,
+    int rows,
+    int columns)
+{
+  using simd_abi_type = p3a::execution::kokkos_serial_policy::simd_abi_type;
+  using mask_type = p3a::simd_mask<double, simd_abi_type>;
+  for (int j = 0; j < columns; ++j) {
+    p3a::simd_for_each<double>(p3a::execution::kokkos_serial,
+        p3a::counting_iterator<int>(0),
+        p3a::counting_iterator<int>(rows),
+    [=] P3A_HOST_DEVICE (int i, mask_type const& mask) P3A_ALWAYS_INLINE {
+      auto const s = stress.load(i, j, mask);
+      static_assert(std::is_same_v<std::remove_const_t<decltype(s)>,
+          p3a::quantity<p3a::simd<double, simd_abi_type>, p3a::gigapascal>>,
+          "loads from quantity views are quantity batches");
+      stress.store(s * 2.0, i, j, mask);
+      total.sum_store(s, i, j, mask);
+    });
+  }
+}
+
+TEST(quantity_simd_view, load_store)
+{
+  int constexpr rows = 6;
+  int constexpr columns = 3;
+  Kokkos::View<double**, Kokkos::LayoutLeft> stress("stress", rows, columns);
+  Kokkos::View<double**, Kokkos::LayoutLeft> total("total", rows, columns);
+  for (int j = 0; j < columns; ++j) {
+    for (int i = 0; i < rows; ++i) {
+      stress(i, j) = 1.0 * i + 10.0 * j;
+      total(i, j) = 1.0;
+    }
+  }
+  double_stress(stress, total, rows, columns);
+  for (int j = 0; j < columns; ++j) {
+    for (int i = 0; i < rows; ++i) {
+      EXPECT_EQ(stress(i, j), 2.0 * (1.0 * i + 10.0 * j));
+      EXPECT_EQ(total(i, j), 1.0 + 1.0 * i + 10.0 * j);
+    }
+  }
+}
@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+#include "p3a_quaternion.hpp"
+#include "p3a_simd.hpp"
+
+#include <vector>
+
+static double rotation_difference(
+    p3a::matrix3x3<double> const& a,
+    p3a::matrix3x3<double> const& b)
+{
+  double result = 0.0;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      result = p3a::max(result, p3a::abs(a(i, j) - b(i, j)));
+    }
+  }
+  return result;
+}
+
+TEST(quaternion, conversions)
+{
+  p3a::axis_angle<double> const aa(p3a::vector3<double>(0.3, -1.2, 0.7));
+  p3a::quaternion<double> const q(aa);
+  EXPECT_NEAR(p3a::magnitude(q), 1.0, 1.0e-15);
+  p3a::matrix3x3<double> const R = aa.tensor();
+  EXPECT_LT(rotation_difference(q.tensor(), R), 1.0e-14);
+  // each pivot of the Markley construction
+  p3a::vector3<double> const vectors[] = {
+    p3a::vector3<double>(0.3, -1.2, 0.7),
+    p3a::vector3<double>(3.0, 0.1, -0.2),
+    p3a::vector3<double>(0.1, -3.0, 0.2),
+    p3a::vector3<double>(-0.2, 0.1, 3.0)};
+  for (auto const& v : vectors) {
+    p3a::matrix3x3<double> const Rv = p3a::axis_angle<double>(v).tensor();
+    p3a::quaternion<double> const qv(Rv);
+    EXPECT_LT(rotation_difference(qv.tensor(), Rv), 1.0e-14);
+    auto const back = qv.to_axis_angle().vector();
+    EXPECT_NEAR(back.x(), v.x(), 1.0e-13);
+    EXPECT_NEAR(back.y(), v.y(), 1.0e-13);
+    EXPECT_NEAR(back.z(), v.z(), 1.0e-13);
+  }
+  auto const tiny = p3a::quaternion<double>(
+      p3a::axis_angle<double>(p3a::vector3<double>(1.0e-20, 0.0, 0.0)));
+  EXPECT_DOUBLE_EQ(tiny.x(), 0.5e-20);
+  EXPECT_DOUBLE_EQ(tiny.to_axis_angle().vector().x(), 1.0e-20);
+}
+
+TEST(quaternion, algebra)
+{
+  p3a::quaternion<double> const a(p3a::axis_angle<double>(p3a::vector3<double>(0.3, -1.2, 0.7)));
+  p3a::quaternion<double> const b(p3a::axis_angle<double>(p3a::vector3<double>(-2.0, 0.5, 1.0)));
+  EXPECT_LT(rotation_difference((a * b).tensor(), a.tensor() * b.tensor()), 1.0e-14);
+  EXPECT_LT(rotation_difference((a * inverse(a)).tensor(), p3a::matrix3x3<double>::identity()), 1.0e-15);
+  p3a::vector3<double> const v(1.0, 2.0, -3.0);
+  auto const rotated = rotate(a, v);
+  auto const expected = a.tensor() * v;
+  EXPECT_NEAR(rotated.x(), expected.x(), 1.0e-14);
+  EXPECT_NEAR(rotated.y(), expected.y(), 1.0e-14);
+  EXPECT_NEAR(rotated.z(), expected.z(), 1.0e-14);
+  // halfway along the arc from a to b is a rotated by half of a^-1 b
+  auto const half = p3a::quaternion<double>(
+      p3a::axis_angle<double>((conjugate(a) * b).to_axis_angle().vector() * 0.5));
+  auto const midpoint = slerp(a, b, 0.5);
+  EXPECT_LT(rotation_difference(midpoint.tensor(), (a * half).tensor()), 1.0e-14);
+  EXPECT_LT(rotation_difference(slerp(a, -b, 0.5).tensor(), midpoint.tensor()), 1.0e-14);
+  EXPECT_LT(rotation_difference(slerp(a, a, 0.25).tensor(), a.tensor()), 1.0e-15);
+  EXPECT_LT(rotation_difference(nlerp(a, b, 0.0).tensor(), a.tensor()), 1.0e-15);
+  EXPECT_LT(rotation_difference(nlerp(a, b, 1.0).tensor(), b.tensor()), 1.0e-15);
+}
+
+TEST(quaternion, simd)
+{
+  using simd_type = p3a::simd<double, p3a::simd_abi::fixed_size<4>>;
+  p3a::vector3<double> const vectors[] = {
+    p3a::vector3<double>(0.3, -1.2, 0.7),
+    p3a::vector3<double>(3.0, 0.1, -0.2),
+    p3a::vector3<double>(0.0, 0.0, 0.0),
+    p3a::vector3<double>(-0.2, 0.1, 3.0)};
+  p3a::matrix3x3<simd_type> R;
+  for (int lane = 0; lane < 4; ++lane) {
+    auto const R_lane = p3a::axis_angle<double>(vectors[lane]).tensor();
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) R(i, j)[lane] = R_lane(i, j);
+    }
+  }
+  p3a::quaternion<simd_type> const q(R);
+  auto const aa = q.to_axis_angle();
+  auto const q2 = slerp(q, q * q, simd_type(0.5));
+  for (int lane = 0; lane < 4; ++lane) {
+    p3a::quaternion<double> const expected(
+        p3a::matrix3x3<double>(
+          R.xx()[lane], R.xy()[lane], R.xz()[lane],
+          R.yx()[lane], R.yy()[lane], R.yz()[lane],
+          R.zx()[lane], R.zy()[lane], R.zz()[lane]));
+    EXPECT_EQ(q.w()[lane], expected.w());
+    EXPECT_EQ(q.x()[lane], expected.x());
+    EXPECT_EQ(q.z()[lane], expected.z());
+    EXPECT_EQ(aa.vector().y()[lane], expected.to_axis_angle().vector().y());
+    auto const q2_expected = slerp(expected, expected * expected, 0.5);
+    EXPECT_NEAR(q2.w()[lane], q2_expected.w(), 1.0e-15);
+    EXPECT_NEAR(q2.y()[lane], q2_expected.y(), 1.0e-15);
+  }
+}
+
+TEST(quaternion, batched)
+{
+  int constexpr count = 7;
+  std::vector<double> q(4 * count);
+  std::vector<double> v(3 * count);
+  for (int i = 0; i < count; ++i) {
+    p3a::quaternion<double> const q_i(p3a::axis_angle<double>(
+          p3a::vector3<double>(0.1 * i, 1.0 - 0.3 * i, 0.5)));
+    p3a::store(q_i, q.data(), count, i);
+    p3a::store(p3a::vector3<double>(1.0 + i, -2.0, 0.5 * i), v.data(), count, i);
+  }
+  std::vector<double> rotated(3 * count);
+  std::vector<double> composed(4 * count);
+  p3a::batched_rotate(p3a::execution::kokkos_serial,
+      count, q.data(), v.data(), rotated.data());
+  p3a::batched_compose(p3a::execution::kokkos_serial,
+      count, q.data(), q.data(), composed.data());
+  for (int i = 0; i < count; ++i) {
+    auto const q_i = p3a::load_quaternion(q.data(), count, i);
+    auto const v_i = p3a::load_vector3(v.data(), count, i);
+    auto const rotated_i = p3a::load_vector3(rotated.data(), count, i);
+    auto const expected = rotate(q_i, v_i);
+    EXPECT_DOUBLE_EQ(rotated_i.x(), expected.x());
+    EXPECT_DOUBLE_EQ(rotated_i.y(), expected.y());
+    EXPECT_DOUBLE_EQ(rotated_i.z(), expected.z());
+    auto const composed_i = p3a::load_quaternion(composed.data(), count, i);
+    EXPECT_DOUBLE_EQ(composed_i.w(), (q_i * q_i).w());
+    EXPECT_DOUBLE_EQ(composed_i.z(), (q_i * q_i).z());
+  }
+}
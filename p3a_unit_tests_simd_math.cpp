@@ -0,0 +1,228 @@
+#include "gtest/gtest.h"
+#include "p3a_simd.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+using simd_type = p3a::simd<double, p3a::simd_abi::fixed_size<4>>;
+
+static std::int64_t ordered_bits(double x)
+{
+  std::int64_t i;
+  std::memcpy(&i, &x, sizeof(i));
+  return (i < 0) ? (std::numeric_limits<std::int64_t>::min() - i) : i;
+}
+
+static std::int64_t ulp_distance(double a, double b)
+{
+  if (std::isnan(a) && std::isnan(b)) return 0;
+  if (std::isnan(a) || std::isnan(b)) return std::numeric_limits<std::int64_t>::max();
+  std::int64_t const d = ordered_bits(a) - ordered_bits(b);
+  return (d < 0) ? -d : d;
+}
+
+static simd_type make_simd(double a, double b, double c, double d)
+{
+  simd_type result;
+  result[0] = a;
+  result[1] = b;
+  result[2] = c;
+  result[3] = d;
+  return result;
+}
+
+template <class F, class G>
+static std::int64_t max_ulp_unary(F const& f, G const& g, double lo, double hi, bool logarithmic = false)
+{
+  int constexpr samples = 4 * 20000;
+  std::int64_t worst = 0;
+  for (int i = 0; i < samples; i += 4) {
+    double x[4];
+    for (int lane = 0; lane < 4; ++lane) {
+      double const t = double(i + lane) / double(samples - 1);
+      x[lane] = logarithmic ? lo * std::pow(hi / lo, t) : lo + (hi - lo) * t;
+    }
+    simd_type const result = f(make_simd(x[0], x[1], x[2], x[3]));
+    for (int lane = 0; lane < 4; ++lane) {
+      worst = std::max(worst, ulp_distance(result[lane], g(x[lane])));
+    }
+  }
+  return worst;
+}
+
+TEST(simd_math, exp_log_cbrt)
+{
+  auto const simd_exp = [] (simd_type const& x) { return p3a::exp(x); };
+  auto const simd_log = [] (simd_type const& x) { return p3a::log(x); };
+  auto const simd_cbrt = [] (simd_type const& x) { return p3a::cbrt(x); };
+  auto const std_exp = [] (double x) { return double(std::exp((long double)x)); };
+  auto const std_log = [] (double x) { return double(std::log((long double)x)); };
+  auto const std_cbrt = [] (double x) { return double(std::cbrt((long double)x)); };
+  EXPECT_LE(max_ulp_unary(simd_exp, std_exp, -745.0, 709.0), 1);
+  EXPECT_LE(max_ulp_unary(simd_exp, std_exp, -1.0, 1.0), 1);
+  EXPECT_LE(max_ulp_unary(simd_log, std_log, 1.0e-310, 1.0e300, true), 1);
+  EXPECT_LE(max_ulp_unary(simd_log, std_log, 0.5, 2.0), 1);
+  EXPECT_LE(max_ulp_unary(simd_cbrt, std_cbrt, 1.0e-310, 1.0e300, true), 1);
+  EXPECT_LE(max_ulp_unary(simd_cbrt, std_cbrt, -8.0, 8.0), 1);
+  double const inf = std::numeric_limits<double>::infinity();
+  double const nan = std::numeric_limits<double>::quiet_NaN();
+  auto const e = p3a::exp(make_simd(-inf, inf, nan, 800.0));
+  EXPECT_EQ(e[0], 0.0);
+  EXPECT_EQ(e[1], inf);
+  EXPECT_TRUE(std::isnan(e[2]));
+  EXPECT_EQ(e[3], inf);
+  auto const l = p3a::log(make_simd(0.0, -1.0, inf, 1.0));
+  EXPECT_EQ(l[0], -inf);
+  EXPECT_TRUE(std::isnan(l[1]));
+  EXPECT_EQ(l[2], inf);
+  EXPECT_EQ(l[3], 0.0);
+  auto const c = p3a::cbrt(make_simd(-0.0, -27.0, -inf, nan));
+  EXPECT_EQ(c[0], 0.0);
+  EXPECT_TRUE(std::signbit(c[0]));
+  EXPECT_EQ(c[1], -3.0);
+  EXPECT_EQ(c[2], -inf);
+  EXPECT_TRUE(std::isnan(c[3]));
+}
+
+TEST(simd_math, sin_cos)
+{
+  auto const simd_sin = [] (simd_type const& x) { return p3a::sin(x); };
+  auto const simd_cos = [] (simd_type const& x) { return p3a::cos(x); };
+  auto const std_sin = [] (double x) { return double(std::sin((long double)x)); };
+  auto const std_cos = [] (double x) { return double(std::cos((long double)x)); };
+  EXPECT_LE(max_ulp_unary(simd_sin, std_sin, -10.0, 10.0), 1);
+  EXPECT_LE(max_ulp_unary(simd_cos, std_cos, -10.0, 10.0), 1);
+  EXPECT_LE(max_ulp_unary(simd_sin, std_sin, -7.0e5, 7.0e5), 1);
+  EXPECT_LE(max_ulp_unary(simd_cos, std_cos, -7.0e5, 7.0e5), 1);
+  // lanes beyond the reduction range take the library path
+  auto const big = p3a::sin(make_simd(1.0, 1.0e10, -1.0e22, 0.5));
+  EXPECT_EQ(big[1], std::sin(1.0e10));
+  EXPECT_EQ(big[2], std::sin(-1.0e22));
+  EXPECT_LE(ulp_distance(big[0], std::sin(1.0)), 1);
+  auto const s = p3a::sin(make_simd(-0.0, 1.0e-300, 0.0, -1.0e-300));
+  EXPECT_TRUE(std::signbit(s[0]));
+  EXPECT_EQ(s[1], 1.0e-300);
+  EXPECT_EQ(s[3], -1.0e-300);
+}
+
+TEST(simd_math, pow_atan2)
+{
+  int constexpr samples = 20000;
+  std::int64_t worst_pow = 0;
+  std::int64_t worst_pow_large = 0;
+  std::int64_t worst_atan2 = 0;
+  for (int i = 0; i < samples; ++i) {
+    double x[4];
+    double y[4];
+    double ax[4];
+    for (int lane = 0; lane < 4; ++lane) {
+      int const k = 4 * i + lane;
+      x[lane] = 1.0e-3 * std::pow(1.0e6, double(k % 997) / 996.0);
+      y[lane] = -60.0 + 120.0 * double(k % 1009) / 1008.0;
+      ax[lane] = (lane % 2 == 0) ? x[lane] - 1.0 : 1.0 - x[lane];
+    }
+    auto const simd_x = make_simd(x[0], x[1], x[2], x[3]);
+    auto const simd_y = make_simd(y[0], y[1], y[2], y[3]);
+    auto const p = p3a::pow(simd_x, simd_y);
+    auto const a = p3a::atan2(simd_y, make_simd(ax[0], ax[1], ax[2], ax[3]));
+    for (int lane = 0; lane < 4; ++lane) {
+      long double const exponent = y[lane] * std::log((long double)x[lane]);
+      std::int64_t const error = ulp_distance(p[lane], double(std::pow((long double)x[lane], (long double)y[lane])));
+      if (std::abs(exponent) < 50.0) worst_pow = std::max(worst_pow, error);
+      else worst_pow_large = std::max(worst_pow_large, error);
+      worst_atan2 = std::max(worst_atan2, ulp_distance(a[lane], double(std::atan2((long double)y[lane], (long double)ax[lane]))));
+    }
+  }
+  EXPECT_LE(worst_pow, 1);
+  EXPECT_LE(worst_pow_large, 12);
+  EXPECT_LE(worst_atan2, 1);
+  double const inf = std::numeric_limits<double>::infinity();
+  double const nan = std::numeric_limits<double>::quiet_NaN();
+  auto const p = p3a::pow(make_simd(-2.0, -2.0, -2.0, 0.0), make_simd(3.0, 2.0, 0.5, -1.0));
+  EXPECT_EQ(p[0], -8.0);
+  EXPECT_EQ(p[1], 4.0);
+  EXPECT_TRUE(std::isnan(p[2]));
+  EXPECT_EQ(p[3], inf);
+  auto const p2 = p3a::pow(make_simd(nan, 1.0, -inf, -0.0), make_simd(0.0, nan, 3.0, -3.0));
+  EXPECT_EQ(p2[0], 1.0);
+  EXPECT_EQ(p2[1], 1.0);
+  EXPECT_EQ(p2[2], -inf);
+  EXPECT_EQ(p2[3], -inf);
+  auto const a = p3a::atan2(make_simd(0.0, -0.0, 0.0, -0.0), make_simd(-0.0, -1.0, 1.0, 0.0));
+  EXPECT_EQ(a[0], std::atan2(0.0, -0.0));
+  EXPECT_EQ(a[1], std::atan2(-0.0, -1.0));
+  EXPECT_TRUE(std::signbit(a[1]));
+  EXPECT_FALSE(std::signbit(a[2]));
+  EXPECT_TRUE(std::signbit(a[3]));
+  auto const a2 = p3a::atan2(make_simd(inf, -inf, 1.0, nan), make_simd(inf, -inf, 0.0, 1.0));
+  EXPECT_EQ(a2[0], std::atan2(inf, inf));
+  EXPECT_EQ(a2[1], std::atan2(-inf, -inf));
+  EXPECT_EQ(a2[2], std::atan2(1.0, 0.0));
+  EXPECT_TRUE(std::isnan(a2[3]));
+}
+
+template <class T, class = void>
+struct has_p3a_exp : std::false_type {};
+
+template <class T>
+struct has_p3a_exp<T, std::void_t<decltype(p3a::exp(std::declval<T const&>()))>> : std::true_type {};
+
+struct not_a_number {};
+
+TEST(simd_math, mixed_arguments)
+{
+  // the generic forwarders only accept arithmetic and SIMD types
+  static_assert(has_p3a_exp<double>::value);
+  static_assert(has_p3a_exp<simd_type>::value);
+  static_assert(!has_p3a_exp<not_a_number>::value);
+  static_assert(std::is_same_v<decltype(p3a::exp(1)), double>);
+  // a scalar argument is broadcast to the vectorized overload
+  static_assert(std::is_same_v<decltype(p3a::pow(simd_type(), 2)), simd_type>);
+  static_assert(std::is_same_v<decltype(p3a::atan2(1.0, simd_type())), simd_type>);
+  auto const x = make_simd(0.5, 2.0, 3.0, 1.0e-3);
+  auto const y = make_simd(-1.0, 0.0, 1.0, -2.0);
+  auto const p1 = p3a::pow(x, 2.5);
+  auto const p2 = p3a::pow(x, simd_type(2.5));
+  auto const p3 = p3a::pow(2, y);
+  auto const p4 = p3a::pow(simd_type(2.0), y);
+  auto const a1 = p3a::atan2(y, -1.0);
+  auto const a2 = p3a::atan2(y, simd_type(-1.0));
+  auto const a3 = p3a::atan2(0.5, x);
+  auto const a4 = p3a::atan2(simd_type(0.5), x);
+  for (int lane = 0; lane < 4; ++lane) {
+    EXPECT_EQ(p1[lane], p2[lane]);
+    EXPECT_EQ(p3[lane], p4[lane]);
+    EXPECT_EQ(a1[lane], a2[lane]);
+    EXPECT_EQ(a3[lane], a4[lane]);
+  }
+}
+
+TEST(simd_math, fast)
+{
+  double worst = 0.0;
+  auto const check = [&] (double value, double expected) {
+    worst = std::max(worst, std::abs(value - expected) / std::abs(expected));
+  };
+  for (int i = 0; i < 4000; ++i) {
+    double const t = double(i) / 3999.0;
+    double const x = -700.0 + 1400.0 * t;
+    double const positive = std::pow(10.0, -300.0 + 600.0 * t);
+    double const angle = -100.0 + 200.0 * t + 1.0e-3;
+    check(p3a::exp_fast(x), std::exp(x));
+    check(p3a::log_fast(positive), std::log(positive));
+    check(p3a::cbrt_fast(x), std::cbrt(x));
+    check(p3a::sin_fast(angle), std::sin(angle));
+    check(p3a::cos_fast(angle), std::cos(angle));
+    check(p3a::atan2_fast(x, angle), std::atan2(x, angle));
+    check(p3a::pow_fast(1.0 + t, x / 20.0), std::pow(1.0 + t, x / 20.0));
+    auto const simd_x = simd_type(x);
+    check(p3a::exp_fast(simd_x)[0], std::exp(x));
+    check(p3a::log_fast(simd_type(positive))[1], std::log(positive));
+    check(p3a::sin_fast(simd_type(angle))[2], std::sin(angle));
+  }
+  EXPECT_LT(worst, 1.0e-8);
+}
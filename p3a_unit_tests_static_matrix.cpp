@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "p3a_static_matrix_solve.hpp"
+#include "p3a_qr.hpp"
+#include "p3a_eigen.hpp"
+
+TEST(static_matrix, lu_solve_pivots)
+{
+  p3a::static_matrix<double, 3, 3> a;
+  a(0, 0) = 0.0; a(0, 1) = 2.0; a(0, 2) = 1.0;
+  a(1, 0) = 1.0; a(1, 1) = 1.0; a(1, 2) = 0.0;
+  a(2, 0) = 3.0; a(2, 1) = 0.0; a(2, 2) = 1.0;
+  p3a::static_vector<double, 3> b;
+  b[0] = 4.5; b[1] = 3.0; b[2] = 6.0;
+  bool const singular = p3a::lu_solve(a, b);
+  EXPECT_FALSE(singular);
+  EXPECT_NEAR(b[0], 1.5, 1.0e-14);
+  EXPECT_NEAR(b[1], 1.5, 1.0e-14);
+  EXPECT_NEAR(b[2], 1.5, 1.0e-14);
+}
+
+template <int N>
+void fill_batched_systems(int count, bool symmetric, std::vector<double>& a, std::vector<double>& b)
+{
+  a.resize(std::size_t(N * N * count));
+  b.resize(std::size_t(N * count));
+  for (int s = 0; s < count; ++s) {
+    for (int i = 0; i < N; ++i) {
+      for (int j = 0; j < N; ++j) {
+        int const p = symmetric ? (i + j) : (i * 3 + j * 5);
+        double value = double((p * 7 + s * 13) % 11) / 11.0 - 0.5;
+        if (i == j) value += symmetric ? double(N) : 0.1 * double(s % 3 + 1);
+        a[std::size_t((i * N + j) * count + s)] = value;
+      }
+      b[std::size_t(i * count + s)] = double(i + s) / double(N);
+    }
+  }
+}
+
+// systems flagged in failed are skipped
+template <int N>
+void check_batched_solutions(int count,
+    std::vector<double> const& a, std::vector<double> const& b, std::vector<double> const& x,
+    bool const* failed)
+{
+  for (int s = 0; s < count; ++s) {
+    if (failed[s]) continue;
+    for (int i = 0; i < N; ++i) {
+      double ax = 0.0;
+      for (int j = 0; j < N; ++j) {
+        ax += a[std::size_t((i * N + j) * count + s)] * x[std::size_t(j * count + s)];
+      }
+      EXPECT_NEAR(ax, b[std::size_t(i * count + s)], 1.0e-10);
+    }
+  }
+}
+
+TEST(static_matrix, batched_lu_solve)
+{
+  int constexpr n = 6;
+  int constexpr count = 10;
+  std::vector<double> a, b;
+  fill_batched_systems<n>(count, false, a, b);
+  // system 3 gets a zero row
+  for (int j = 0; j < n; ++j) a[std::size_t((2 * n + j) * count + 3)] = 0.0;
+  auto const singular = std::make_unique<bool[]>(std::size_t(count));
+  std::vector<double> x = b;
+  p3a::batched_lu_solve<n>(p3a::execution::kokkos_serial, count, a.data(), x.data(), singular.get());
+  for (int s = 0; s < count; ++s) EXPECT_EQ(singular[std::size_t(s)], s == 3);
+  check_batched_solutions<n>(count, a, b, x, singular.get());
+  x = b;
+  p3a::batched_lu_solve<n>(p3a::execution::seq, count, a.data(), x.data(), singular.get());
+  for (int s = 0; s < count; ++s) EXPECT_EQ(singular[std::size_t(s)], s == 3);
+  check_batched_solutions<n>(count, a, b, x, singular.get());
+}
+
+TEST(static_matrix, batched_cholesky_solve)
+{
+  int constexpr n = 8;
+  int constexpr count = 7;
+  std::vector<double> a, b;
+  fill_batched_systems<n>(count, true, a, b);
+  // system 5 is indefinite
+  a[std::size_t((1 * n + 1) * count + 5)] = -1.0;
+  auto const not_positive_definite = std::make_unique<bool[]>(std::size_t(count));
+  std::vector<double> x = b;
+  p3a::batched_cholesky_solve<n>(p3a::execution::kokkos_serial, count, a.data(), x.data(),
+      not_positive_definite.get());
+  for (int s = 0; s < count; ++s) EXPECT_EQ(not_positive_definite[std::size_t(s)], s == 5);
+  check_batched_solutions<n>(count, a, b, x, not_positive_definite.get());
+}
+
+TEST(static_matrix, batched_least_squares)
+{
+  int constexpr m = 10;
+  int constexpr n = 4;
+  int constexpr count = 9;
+  std::vector<double> a(std::size_t(m * n * count));
+  std::vector<double> b(std::size_t(m * count));
+  std::vector<double> x(std::size_t(n * count));
+  // fit a cubic through points that lie exactly on one
+  for (int s = 0; s < count; ++s) {
+    for (int i = 0; i < m; ++i) {
+      double const t = double(i) / double(m - 1) - 0.5 * double(s % 2);
+      double power = 1.0;
+      for (int j = 0; j < n; ++j) {
+        a[std::size_t((i * n + j) * count + s)] = power;
+        power *= t;
+      }
+      b[std::size_t(i * count + s)] = 1.0 + double(s) * t - 2.0 * t * t * t;
+    }
+  }
+  // problem 4 loses its quadratic column
+  int constexpr deficient = 4;
+  for (int i = 0; i < m; ++i) {
+    a[std::size_t((i * n + 2) * count + deficient)] = 0.0;
+  }
+  auto rank_deficient = std::make_unique<bool[]>(std::size_t(count));
+  p3a::batched_least_squares<m, n>(p3a::execution::kokkos_serial, count, a.data(), b.data(), x.data(),
+      rank_deficient.get());
+  for (int s = 0; s < count; ++s) {
+    EXPECT_EQ(rank_deficient[std::size_t(s)], s == deficient);
+    if (s == deficient) continue;
+    EXPECT_NEAR(x[std::size_t(0 * count + s)], 1.0, 1.0e-12);
+    EXPECT_NEAR(x[std::size_t(1 * count + s)], double(s), 1.0e-12);
+    EXPECT_NEAR(x[std::size_t(2 * count + s)], 0.0, 1.0e-12);
+    EXPECT_NEAR(x[std::size_t(3 * count + s)], -2.0, 1.0e-12);
+  }
+}
+
+template <int N, class Eigendecompose>
+void test_jacobi_ordering(Eigendecompose eigendecompose_function)
+{
+  p3a::static_matrix<double, N, N> a;
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      a(i, j) = a(j, i) = double((i * 7 + j * 3) % 11) / 11.0 - 0.5 + ((i == j) ? double(i) : 0.0);
+    }
+  }
+  auto const original = a;
+  p3a::static_matrix<double, N, N> q;
+  eigendecompose_function(a, q, 1.0e-14);
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      double qtq = 0.0;
+      double aq = 0.0;
+      for (int k = 0; k < N; ++k) {
+        qtq += q(k, i) * q(k, j);
+        aq += original(i, k) * q(k, j);
+      }
+      EXPECT_NEAR(qtq, (i == j) ? 1.0 : 0.0, 1.0e-13);
+      // A q_j = lambda_j q_j
+      EXPECT_NEAR(aq, a(j, j) * q(i, j), 1.0e-12);
+      if (i != j) {
+        EXPECT_NEAR(a(i, j), 0.0, 1.0e-13);
+      }
+    }
+  }
+}
+
+TEST(static_matrix, jacobi_orderings)
+{
+  auto const cyclic = [] (auto& a, auto& q, double tolerance) {
+    p3a::cyclic_jacobi_eigendecompose(a, q, tolerance);
+  };
+  auto const parallel = [] (auto& a, auto& q, double tolerance) {
+    p3a::parallel_jacobi_eigendecompose(a, q, tolerance);
+  };
+  test_jacobi_ordering<6>(cyclic);
+  test_jacobi_ordering<6>(parallel);
+  test_jacobi_ordering<5>(cyclic);
+  test_jacobi_ordering<5>(parallel);
+}
+
+TEST(static_matrix, parallel_jacobi_simd)
+{
+  using simd_type = p3a::simd<double, p3a::simd_abi::fixed_size<4>>;
+  int constexpr n = 6;
+  p3a::static_matrix<simd_type, n, n> a;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      for (int lane = 0; lane < 4; ++lane) {
+        // lane 1 is already diagonal
+        double const value = (lane == 1 && i != j) ? 0.0 :
+          double((i * 5 + j * 3 + lane) % 7) / 7.0 + ((i == j) ? double(i + lane) : 0.0);
+        a(i, j)[lane] = value;
+        a(j, i)[lane] = value;
+      }
+    }
+  }
+  auto const original = a;
+  p3a::static_matrix<simd_type, n, n> q;
+  p3a::parallel_jacobi_eigendecompose(a, q, simd_type(1.0e-14));
+  for (int lane = 0; lane < 4; ++lane) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        double aq = 0.0;
+        for (int k = 0; k < n; ++k) aq += original(i, k)[lane] * q(k, j)[lane];
+        EXPECT_NEAR(aq, a(j, j)[lane] * q(i, j)[lane], 1.0e-12);
+      }
+    }
+  }
+  EXPECT_EQ(q(0, 1)[1], 0.0);
+  EXPECT_EQ(a(2, 2)[1], original(2, 2)[1]);
+}
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "p3a_symmetric3x3.hpp"
+#include "p3a_eigen.hpp"
 
 TEST(symmetric3x3, isotropic_part){
   using T = double;
@@ -76,3 +77,92 @@ TEST(symmetric3x3, inverse){
   EXPECT_FLOAT_EQ(ai.xz(), -0.019193857965451054);
   EXPECT_FLOAT_EQ(ai.yz(), -0.028790786948176588);
 }
+
+template <class T>
+void check_eigendecomposition(p3a::symmetric3x3<T> const& a, double tolerance)
+{
+  p3a::diagonal3x3<T> l;
+  p3a::matrix3x3<T> q;
+  eigendecompose(a, l, q);
+  EXPECT_GE(l.xx(), l.yy());
+  EXPECT_GE(l.yy(), l.zz());
+  EXPECT_NEAR(determinant(q), 1.0, tolerance);
+  double const scale = p3a::max(maximum_norm(a), 1.0);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      double qqt = 0.0;
+      double qlqt = 0.0;
+      for (int k = 0; k < 3; ++k) {
+        qqt += q(i, k) * q(j, k);
+        double const l_k = (k == 0) ? l.xx() : ((k == 1) ? l.yy() : l.zz());
+        qlqt += q(i, k) * l_k * q(j, k);
+      }
+      EXPECT_NEAR(qqt, (i == j) ? 1.0 : 0.0, tolerance);
+      EXPECT_NEAR(qlqt, a(i, j), tolerance * scale);
+    }
+  }
+  auto const eigenvalues_only = eigenvalues(a);
+  EXPECT_NEAR(eigenvalues_only.xx(), l.xx(), 1.0e-7 * scale);
+  EXPECT_NEAR(eigenvalues_only.yy(), l.yy(), 1.0e-7 * scale);
+  EXPECT_NEAR(eigenvalues_only.zz(), l.zz(), 1.0e-7 * scale);
+}
+
+TEST(symmetric3x3, eigendecompose){
+  using T = double;
+  check_eigendecomposition(p3a::symmetric3x3<T>{1., .5, .1, 2., .2, 3.}, 1.0e-13);
+  check_eigendecomposition(p3a::symmetric3x3<T>{-4., 1., 2., 3., -1., .5}, 1.0e-13);
+  // repeated eigenvalues in either position
+  check_eigendecomposition(p3a::symmetric3x3<T>{2., 0., 0., 5., 0., 2.}, 1.0e-13);
+  check_eigendecomposition(p3a::symmetric3x3<T>{3., 1., 1., 3., 1., 3.}, 1.0e-13);
+  check_eigendecomposition(p3a::symmetric3x3<T>{1., 1.0e-9, 0., 1., 0., 1. + 1.0e-9}, 1.0e-13);
+  check_eigendecomposition(p3a::symmetric3x3<T>{1.0e200, 3.0e199, 0., -2.0e200, 1.0e199, 5.0e199}, 1.0e-13);
+  check_eigendecomposition(p3a::symmetric3x3<T>{1.0e-200, 3.0e-201, 0., -2.0e-200, 0., 0.}, 1.0e-13);
+  p3a::diagonal3x3<T> l;
+  p3a::matrix3x3<T> q;
+  eigendecompose(p3a::symmetric3x3<T>{7., 0., 0., 7., 0., 7.}, l, q);
+  EXPECT_EQ(l.yy(), 7.);
+  EXPECT_EQ(q.xx(), 1.);
+  EXPECT_EQ(q.yy(), 1.);
+  EXPECT_EQ(q.zz(), 1.);
+  eigendecompose(p3a::symmetric3x3<T>::zero(), l, q);
+  EXPECT_EQ(l.xx(), 0.);
+  EXPECT_EQ(q.xy(), 0.);
+}
+
+TEST(symmetric3x3, eigendecompose_simd){
+  using simd_type = p3a::simd<double, p3a::simd_abi::fixed_size<4>>;
+  double const lanes[4][6] = {
+    {1., .5, .1, 2., .2, 3.},
+    {7., 0., 0., 7., 0., 7.},
+    {3., 1., 1., 3., 1., 3.},
+    {-4., 1., 2., 3., -1., .5}};
+  p3a::symmetric3x3<simd_type> a;
+  for (int lane = 0; lane < 4; ++lane) {
+    a.xx()[lane] = lanes[lane][0];
+    a.xy()[lane] = lanes[lane][1];
+    a.xz()[lane] = lanes[lane][2];
+    a.yy()[lane] = lanes[lane][3];
+    a.yz()[lane] = lanes[lane][4];
+    a.zz()[lane] = lanes[lane][5];
+  }
+  p3a::diagonal3x3<simd_type> l;
+  p3a::matrix3x3<simd_type> q;
+  eigendecompose(a, l, q);
+  for (int lane = 0; lane < 4; ++lane) {
+    p3a::symmetric3x3<double> const a_lane(
+        lanes[lane][0], lanes[lane][1], lanes[lane][2],
+        lanes[lane][3], lanes[lane][4], lanes[lane][5]);
+    p3a::diagonal3x3<double> l_lane;
+    p3a::matrix3x3<double> q_lane;
+    eigendecompose(a_lane, l_lane, q_lane);
+    // the simd cos is vectorized and may differ from the scalar one by an ULP
+    EXPECT_NEAR(l.xx()[lane], l_lane.xx(), 1.0e-14);
+    EXPECT_NEAR(l.yy()[lane], l_lane.yy(), 1.0e-14);
+    EXPECT_NEAR(l.zz()[lane], l_lane.zz(), 1.0e-14);
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        EXPECT_NEAR(q(i, j)[lane], q_lane(i, j), 1.0e-14);
+      }
+    }
+  }
+}
@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "p3a_tensor_expression.hpp"
+#include "p3a_simd.hpp"
+
+TEST(tensor_expression, matrix3x3)
+{
+  using matrix_type = p3a::matrix3x3<double>;
+  matrix_type const a(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 10.0);
+  matrix_type const b(0.5, -1.0, 2.0, 0.0, 3.0, -2.0, 1.5, 1.0, -0.5);
+  p3a::symmetric3x3<double> const s(1.0, 0.2, 0.3, 2.0, 0.4, 3.0);
+  double const scale = 0.25;
+  matrix_type const lazy_result =
+    p3a::evaluate((p3a::lazy(a) * scale - p3a::identity3x3 + 2.0 * (p3a::lazy(b) - s)) / 3.0);
+  matrix_type const eager_result =
+    (a * scale - matrix_type::identity() + 2.0 * (b - matrix_type(s))) / 3.0;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_DOUBLE_EQ(lazy_result(i, j), eager_result(i, j));
+    }
+  }
+  matrix_type const negated = p3a::evaluate(-p3a::lazy(a) + b);
+  EXPECT_DOUBLE_EQ(negated(2, 1), b(2, 1) - a(2, 1));
+}
+
+TEST(tensor_expression, symmetric3x3)
+{
+  using symmetric_type = p3a::symmetric3x3<double>;
+  symmetric_type const s(1.0, 0.2, 0.3, 2.0, 0.4, 3.0);
+  symmetric_type const t(-1.0, 0.5, 0.0, 4.0, -0.4, 1.0);
+  // all-symmetric operands evaluate to a symmetric3x3
+  auto const result = p3a::evaluate((p3a::lazy(s) - p3a::identity3x3) * 0.5 + t);
+  static_assert(std::is_same_v<std::remove_const_t<decltype(result)>, symmetric_type>);
+  symmetric_type const expected = (s - symmetric_type::identity()) * 0.5 + t;
+  EXPECT_DOUBLE_EQ(result.xx(), expected.xx());
+  EXPECT_DOUBLE_EQ(result.xy(), expected.xy());
+  EXPECT_DOUBLE_EQ(result.yz(), expected.yz());
+  EXPECT_DOUBLE_EQ(result.zz(), expected.zz());
+}
+
+TEST(tensor_expression, mandel6x6)
+{
+  p3a::mandel6x6<double> const c = p3a::isotropic_mandel6x6(2.0, 1.0);
+  p3a::mandel6x6<double> const d = p3a::cubic_mandel6x6(3.0, 1.0, 0.5);
+  auto const result = p3a::evaluate(p3a::lazy(c) * 2.0 - d);
+  auto const expected = c * 2.0 - d;
+  EXPECT_DOUBLE_EQ(result.x11(), expected.x11());
+  EXPECT_DOUBLE_EQ(result.x12(), expected.x12());
+  EXPECT_DOUBLE_EQ(result.x44(), expected.x44());
+  EXPECT_DOUBLE_EQ(result.x65(), expected.x65());
+}
+
+TEST(tensor_expression, simd)
+{
+  using simd_type = p3a::simd<double, p3a::simd_abi::fixed_size<4>>;
+  p3a::matrix3x3<simd_type> a;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      for (int lane = 0; lane < 4; ++lane) a(i, j)[lane] = double(3 * i + j + lane);
+    }
+  }
+  simd_type scale(0.5);
+  auto const result = p3a::evaluate((p3a::lazy(a) * scale - p3a::identity3x3) * 2.0);
+  for (int lane = 0; lane < 4; ++lane) {
+    EXPECT_DOUBLE_EQ(result(0, 0)[lane], double(lane) - 2.0);
+    EXPECT_DOUBLE_EQ(result(1, 2)[lane], double(5 + lane));
+  }
+}
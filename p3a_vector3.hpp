@@ -366,7 +366,8 @@ void store(
 
 template <class T, class Mask>
 [[nodiscard]] P3A_ALWAYS_INLINE P3A_HOST_DEVICE inline
-vector3<T> condition(
+std::enable_if_t<!std::is_same_v<Mask, bool>, vector3<T>>
+condition(
     Mask const& a,
     vector3<T> const& b,
     vector3<T> const& c)